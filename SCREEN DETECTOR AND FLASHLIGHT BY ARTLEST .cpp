@@ -7,16 +7,825 @@
  * using standard C++ libraries for cross-platform compatibility.
  */
 
-#include <iostream>  // This library provides input/output stream functionality for console operations
-#include <iomanip>   // This library enables formatted output manipulation and precision control
+#include <cstdio>    // This library provides snprintf and the stdio fallback of the console writer
 #include <thread>    // This library supplies threading functionality for timing operations
 #include <chrono>    // This library manages time-based operations and duration calculations
 #include <string>    // This library manages string operations and text processing
 #include <cstdlib>   // This library provides system utilities and screen clearing functions
+#include <vector>    // This library provides dynamic arrays for sink and frame bookkeeping
+#include <mutex>     // This library provides mutual exclusion for state shared between threads
+#include <atomic>    // This library provides lock-free flags shared between threads
+#include <cstring>   // This library provides C string helpers for error reporting
+#include <cerrno>    // This library exposes error codes reported by system calls
+#include <csignal>   // This library controls signal dispositions such as SIGPIPE
+#include <cstdint>   // This library provides fixed-width integer types
+#include <array>     // This library provides fixed-size tables such as the gamma lookup table
+#include <cmath>     // This library provides trigonometry for the beam geometry
+#include <new>       // This library declares the replaceable global allocation functions
+#include <string_view> // This library provides non-owning string references for pattern names
+#include <memory_resource> // This library provides the monotonic arena for compiled light programs
+#include <charconv>  // This library provides locale-free integer formatting for status text
+#include <algorithm> // This library provides sorting for latency percentiles
+#include <type_traits> // This library restricts the console writer's integer overload
+
+#ifdef __linux__
+#include <fcntl.h>        // This header provides file descriptor flags for non-blocking output
+#include <unistd.h>       // This header provides the write and close system calls
+#include <sys/epoll.h>    // This header provides the epoll readiness notification interface
+#include <sys/eventfd.h>  // This header provides the eventfd wakeup descriptor
+#include <sys/mman.h>     // This header provides shared-memory mapping for the synchronized clock
+#include <sys/file.h>     // This header provides flock for serializing access to the synchronized clock
+#include <sys/stat.h>     // This header provides permission bits for shared-memory segments
+#include <sys/wait.h>     // This header provides waitpid for the phase error test
+#include <time.h>         // This header provides clock_nanosleep for absolute deadlines
+#include <sys/ioctl.h>    // This header provides TIOCGWINSZ for querying the terminal size
+#include <sys/resource.h> // This header provides getrusage for peak resident set measurements
+#include <poll.h>         // This header provides ppoll for waits that a pause request can interrupt
+#include <sys/timerfd.h>  // This header provides absolute-deadline timer descriptors
+#include <pthread.h>      // This header provides pthread_kill for directing pause requests at a thread
+#include <sched.h>        // This header provides SCHED_FIFO and CPU affinity masks for the timing thread
+#include <sys/prctl.h>    // This header provides PR_SET_TIMERSLACK and PR_SET_PDEATHSIG
+#include <sys/signalfd.h> // This header provides signalfd so signals arrive as event loop readiness
+#include <sys/socket.h>   // This header provides the datagram socket that accepts control commands
+#include <sys/un.h>       // This header provides Unix domain socket addresses
+#endif
+
+// Benchmark-only builds (-DFLASHLIGHT_STREAM_BASELINES) time the iostream code the console writer replaced;
+// the shipping binary leaves iostream out entirely
+#ifdef FLASHLIGHT_STREAM_BASELINES
+#include <ostream>        // This library provides the stream baseline measured by the formatting benchmarks
+#include <iostream>       // This library provides cout for the row fill benchmark's per-glyph baseline
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>    // This header provides SSE2 intrinsics for the dither inner loop
+#endif
 
 using namespace std;
 using namespace std::chrono;
 
+// Formatting controls understood by console_output_stream
+enum console_output_control { OUTPUT_END_LINE, OUTPUT_FLUSH, OUTPUT_GENERAL_FLOAT };
+const console_output_control end_line = OUTPUT_END_LINE;           // Newline; flushes on a terminal
+const console_output_control flush_output = OUTPUT_FLUSH;          // Write buffered bytes now
+const console_output_control general_float = OUTPUT_GENERAL_FLOAT; // Six significant digits, like printf %g
+
+struct console_field_width { int width; };
+struct console_fixed_decimals { int decimals; };
+
+// Right-aligns the next inserted value in a field of the given width
+constexpr console_field_width set_width(int width) { return {width}; }
+
+// Prints following floating-point values with a fixed number of decimals
+constexpr console_fixed_decimals fixed_decimals(int decimals) { return {decimals}; }
+
+// Buffered console writer on write(2) that replaces iostream, so output involves no locale,
+// stream state or iostream static initialization; a descriptor of -1 discards everything
+class console_output_stream {
+public:
+    console_output_stream(int descriptor, bool always_flush_lines)
+        : file_descriptor(descriptor), flush_each_line(always_flush_lines) {
+#ifdef __linux__
+        // Lines reach a terminal immediately; pipes and files are written in whole buffers
+        flush_each_line = flush_each_line || isatty(descriptor);
+#else
+        flush_each_line = true;
+#endif
+    }
+    
+    ~console_output_stream() { flush_buffer(); }
+    
+    // Points the writer at another descriptor and returns the previous one
+    int redirect(int descriptor) {
+        flush_buffer();
+        int previous_descriptor = file_descriptor;
+        file_descriptor = descriptor;
+        return previous_descriptor;
+    }
+    
+    void write_bytes(const char* bytes, size_t byte_count) {
+        if (byte_count > sizeof(buffer) - buffered_length) {
+            flush_buffer();
+            if (byte_count >= sizeof(buffer)) {
+                write_to_descriptor(bytes, byte_count);
+                return;
+            }
+        }
+        memcpy(buffer + buffered_length, bytes, byte_count);
+        buffered_length += byte_count;
+    }
+    
+    void flush_buffer() {
+        write_to_descriptor(buffer, buffered_length);
+        buffered_length = 0;
+    }
+    
+    console_output_stream& operator<<(string_view text) {
+        write_padded(text.data(), text.size());
+        return *this;
+    }
+    
+    console_output_stream& operator<<(const char* text) { return *this << string_view(text); }
+    console_output_stream& operator<<(const string& text) { return *this << string_view(text); }
+    console_output_stream& operator<<(char character) { return *this << string_view(&character, 1); }
+    
+    // Integers are formatted with to_chars; byte-sized integers are rejected rather than printed as text
+    template <typename integer_type,
+              typename = enable_if_t<is_integral_v<integer_type> && (sizeof(integer_type) > 1)>>
+    console_output_stream& operator<<(integer_type value) {
+        char digits[24];
+        char* digits_end = to_chars(digits, digits + sizeof(digits), value).ptr;
+        write_padded(digits, static_cast<size_t>(digits_end - digits));
+        return *this;
+    }
+    
+    // Doubles only appear in reports, so they use libc formatting rather than the large to_chars tables
+    console_output_stream& operator<<(double value) {
+        char digits[64];
+        int digit_count = float_decimals < 0 ? snprintf(digits, sizeof(digits), "%g", value)
+                                             : snprintf(digits, sizeof(digits), "%.*f", float_decimals, value);
+        write_padded(digits, static_cast<size_t>(min(max(digit_count, 0), static_cast<int>(sizeof(digits)) - 1)));
+        return *this;
+    }
+    
+    console_output_stream& operator<<(console_output_control control) {
+        if (control == OUTPUT_END_LINE) {
+            write_bytes("\n", 1);
+            if (flush_each_line) {
+                flush_buffer();
+            }
+        } else if (control == OUTPUT_FLUSH) {
+            flush_buffer();
+        } else {
+            float_decimals = -1;
+        }
+        return *this;
+    }
+    
+    console_output_stream& operator<<(console_field_width field_width) {
+        pending_width = field_width.width;
+        return *this;
+    }
+    
+    console_output_stream& operator<<(console_fixed_decimals decimals) {
+        float_decimals = decimals.decimals;
+        return *this;
+    }
+
+private:
+    // Applies a pending set_width by left-padding with spaces, then appends the value
+    void write_padded(const char* bytes, size_t byte_count) {
+        static const char padding[] = "                                ";
+        size_t field_width = static_cast<size_t>(max(0, pending_width));
+        for (size_t padding_count = field_width > byte_count ? field_width - byte_count : 0; padding_count > 0;) {
+            size_t chunk = min(padding_count, sizeof(padding) - 1);
+            write_bytes(padding, chunk);
+            padding_count -= chunk;
+        }
+        pending_width = 0;
+        write_bytes(bytes, byte_count);
+    }
+    
+    void write_to_descriptor(const char* bytes, size_t byte_count) {
+        if (file_descriptor < 0) {
+            return;
+        }
+#ifdef __linux__
+        while (byte_count > 0) {
+            ssize_t bytes_written = write(file_descriptor, bytes, byte_count);
+            if (bytes_written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            bytes += bytes_written;
+            byte_count -= static_cast<size_t>(bytes_written);
+        }
+#else
+        FILE* output_file = file_descriptor == 2 ? stderr : stdout;
+        fwrite(bytes, 1, byte_count, output_file);
+        fflush(output_file);
+#endif
+    }
+    
+    int file_descriptor;                // Destination descriptor, or -1 to discard
+    bool flush_each_line;               // Whether end_line writes the buffer out
+    char buffer[8192];                  // Bytes not yet written
+    size_t buffered_length = 0;         // Bytes used in buffer
+    int pending_width = 0;              // Field width for the next inserted value
+    int float_decimals = -1;            // Fixed decimals for doubles, or -1 for general format
+};
+
+// Console writers: standard output is flushed per line only on a terminal, errors always are
+console_output_stream console_output(1, false);
+console_output_stream console_error(2, true);
+
+// Identifiers of the illumination patterns shared with other processes
+enum illumination_pattern_id : uint32_t {
+    PATTERN_OFF = 0,
+    PATTERN_STEADY_BRIGHT = 1,
+    PATTERN_STROBE_FLASH = 2,
+    PATTERN_EMERGENCY_FLASH = 3,
+    PATTERN_VARIABLE_BRIGHTNESS = 4
+};
+
+// One light state change positioned on a timeline relative to its origin
+struct timeline_edge {
+    long long offset_microseconds;      // Time of the edge measured from the timeline origin
+    illumination_pattern_id pattern;    // Pattern shown from this edge until the next one
+    int intensity_level;                // Intensity percentage shown from this edge
+};
+
+// A repeating pattern whose edges can be aligned to an absolute shared timeline
+struct synchronized_cycle {
+    const char* pattern_name;           // Name accepted by --sync
+    illumination_pattern_id pattern;    // Identifier published in the shared clock segment
+    const timeline_edge* edges;         // Edges of one cycle in ascending offset order
+    size_t edge_count;                  // Number of edges in one cycle
+    long long cycle_microseconds;       // Length of one complete cycle
+};
+
+// One constant light state of a built-in pattern, declared at compile time
+struct pattern_segment {
+    illumination_pattern_id pattern;    // Pattern shown for the whole segment
+    int intensity_level;                // Intensity percentage shown for the whole segment
+    long long duration_microseconds;    // Length of the segment
+    const char* narration;              // Console narration printed when the segment starts
+};
+
+// This function sums segment durations into the length of one pattern cycle
+template <size_t segment_count>
+constexpr long long total_segment_duration(const array<pattern_segment, segment_count>& segments) {
+    long long total_microseconds = 0;
+    for (const pattern_segment& segment : segments) {
+        total_microseconds += segment.duration_microseconds;
+    }
+    return total_microseconds;
+}
+
+// This function checks durations, intensities and that consecutive segments really change state
+template <size_t segment_count>
+constexpr bool segments_are_well_formed(const array<pattern_segment, segment_count>& segments) {
+    for (size_t segment_index = 0; segment_index < segment_count; segment_index++) {
+        const pattern_segment& segment = segments[segment_index];
+        if (segment.duration_microseconds <= 0 || segment.intensity_level < 0 || segment.intensity_level > 100) {
+            return false;
+        }
+        if (segment.pattern == PATTERN_OFF && segment.intensity_level != 0) {
+            return false;
+        }
+        const pattern_segment& next_segment = segments[(segment_index + 1) % segment_count];
+        if (segment_count > 1 && next_segment.pattern == segment.pattern &&
+            next_segment.intensity_level == segment.intensity_level) {
+            return false;
+        }
+    }
+    return segment_count > 0;
+}
+
+// This function turns segments into the absolute edge table used by timeline playback
+template <size_t segment_count>
+constexpr array<timeline_edge, segment_count> build_timeline_edges(const array<pattern_segment, segment_count>& segments) {
+    array<timeline_edge, segment_count> edges{};
+    long long offset_microseconds = 0;
+    for (size_t segment_index = 0; segment_index < segment_count; segment_index++) {
+        edges[segment_index] = {offset_microseconds, segments[segment_index].pattern,
+                                segments[segment_index].intensity_level};
+        offset_microseconds += segments[segment_index].duration_microseconds;
+    }
+    return edges;
+}
+
+// This function expands a Morse string of dots and dashes into flash and pause segments
+template <size_t symbol_bytes>
+constexpr array<pattern_segment, 2 * (symbol_bytes - 1)> build_morse_segments(const char (&symbols)[symbol_bytes]) {
+    array<pattern_segment, 2 * (symbol_bytes - 1)> segments{};
+    for (size_t symbol_index = 0; symbol_index + 1 < symbol_bytes; symbol_index++) {
+        bool long_flash = symbols[symbol_index] == '-';
+        segments[2 * symbol_index] = {PATTERN_EMERGENCY_FLASH, 100, long_flash ? 800000 : 300000,
+                                      long_flash ? "SOS SIGNAL: LONG FLASH" : "SOS SIGNAL: SHORT FLASH"};
+        segments[2 * symbol_index + 1] = {PATTERN_OFF, 0, 200000, "Signal pause..."};
+    }
+    return segments;
+}
+
+// Strobe cycle: a 200 ms flash followed by a 500 ms pause
+constexpr array<pattern_segment, 2> strobe_cycle_segments = {{
+    {PATTERN_STROBE_FLASH, 100, 200000, "HIGH INTENSITY"},
+    {PATTERN_OFF, 0, 500000, "Flash interval pause..."},
+}};
+
+// SOS cycle: 300 ms short and 800 ms long flashes, each followed by a 200 ms pause
+constexpr array<pattern_segment, 18> emergency_cycle_segments = build_morse_segments("...---...");
+
+constexpr array<timeline_edge, 2> strobe_cycle_edges = build_timeline_edges(strobe_cycle_segments);
+constexpr array<timeline_edge, 18> emergency_cycle_edges = build_timeline_edges(emergency_cycle_segments);
+
+static_assert(segments_are_well_formed(strobe_cycle_segments), "strobe segments must be valid state changes");
+static_assert(segments_are_well_formed(emergency_cycle_segments), "SOS segments must be valid state changes");
+static_assert(total_segment_duration(strobe_cycle_segments) == 700000, "strobe cycle must last 700 ms");
+static_assert(total_segment_duration(emergency_cycle_segments) == 6000000, "SOS cycle must last 6 s");
+static_assert(emergency_cycle_edges[6].offset_microseconds == 1500000 &&
+              emergency_cycle_edges[17].offset_microseconds == 5800000,
+              "SOS edges must start the long flashes at 1.5 s and the last pause at 5.8 s");
+
+// One level of the brightness demonstration with its precomposed status title
+struct brightness_demonstration_step {
+    int intensity_level;                // Level faded to and then held
+    const char* description;            // Name of the level in the narration
+    const char* mode_title;             // Operational mode title shown for the level
+};
+
+constexpr long long brightness_fade_microseconds = 500000;   // Eased fade into each level
+constexpr long long brightness_hold_microseconds = 1000000;  // Hold after the fade completes
+
+constexpr array<brightness_demonstration_step, 4> brightness_demonstration_steps = {{
+    {25, "LOW", "BRIGHTNESS: LOW"},
+    {50, "MEDIUM", "BRIGHTNESS: MEDIUM"},
+    {75, "HIGH", "BRIGHTNESS: HIGH"},
+    {100, "MAXIMUM", "BRIGHTNESS: MAXIMUM"},
+}};
+
+// This function checks that the demonstration steps rise strictly and stay within 1-100 %
+constexpr bool brightness_steps_are_ascending() {
+    int previous_level = 0;
+    for (const brightness_demonstration_step& step : brightness_demonstration_steps) {
+        if (step.intensity_level <= previous_level || step.intensity_level > 100) {
+            return false;
+        }
+        previous_level = step.intensity_level;
+    }
+    return true;
+}
+
+static_assert(brightness_steps_are_ascending(), "brightness steps must rise strictly up to 100 %");
+static_assert(brightness_fade_microseconds + brightness_hold_microseconds == 1500000,
+              "each brightness step must last 1.5 s");
+
+// Layout of the shared-memory clock all synchronized instances attach to
+const int SYNCHRONIZED_MAXIMUM_INSTANCES = 64;        // Instances that can play on one clock segment at once
+
+struct synchronized_clock_segment {
+    atomic<uint32_t> segment_state;     // Becomes SYNCHRONIZED_SEGMENT_READY once epoch and pattern are valid
+    uint32_t pattern_id;                // Pattern every attached instance plays
+    long long epoch_nanoseconds;        // CLOCK_MONOTONIC origin of the shared timeline
+    atomic<uint32_t> attached_instances; // Reference count: instances currently playing on this timeline
+    int32_t attached_processes[SYNCHRONIZED_MAXIMUM_INSTANCES]; // Process of each playing instance, 0 for a free slot
+};
+
+const uint32_t SYNCHRONIZED_SEGMENT_READY = 0x41525453; // Marks an initialized clock segment
+
+const uint32_t LIGHT_FRAME_RING_MAGIC = 0x4C465247;    // Marks an initialized frame ring segment
+const uint32_t LIGHT_FRAME_RING_CAPACITY = 1024;       // Slots in the frame ring (about one second at 1 kHz)
+
+// Easing curves available to brightness ramps
+enum brightness_ramp_curve {
+    RAMP_LINEAR,           // Constant rate of change
+    RAMP_EASE_IN_OUT,      // Smoothstep: slow start, fast middle, slow finish
+    RAMP_EXPONENTIAL       // Doubling rate, perceived as an even fade on a luminance scale
+};
+
+// Lateness histogram buckets: exact below 4 us, then four buckets per power of two up to 131 ms
+constexpr int LATENESS_HISTOGRAM_BUCKETS = 64;
+
+// Frame timing measurements collected while a ramp or timed animation plays
+struct frame_pacing_statistics {
+    long long frames_rendered = 0;         // Frames drawn
+    long long deadlines_missed = 0;        // Frames that finished after the next frame was due
+    long long total_lateness_nanoseconds = 0;   // Sum of wake-up lateness against each frame deadline
+    long long maximum_lateness_nanoseconds = 0; // Worst wake-up lateness
+    array<uint32_t, LATENESS_HISTOGRAM_BUCKETS> lateness_histogram = {}; // Frames per lateness bucket, for percentiles
+};
+
+// Requested and measured duty cycle of one temporally dithered intensity hold
+struct pwm_duty_statistics {
+    int requested_intensity = 0;           // Intensity percentage that was approximated
+    double requested_duty = 0.0;           // Fraction of each period the upper glyph should be shown
+    double achieved_duty = 0.0;            // Fraction of the hold the upper glyph was actually shown
+    long long periods_completed = 0;       // PWM periods played during the hold
+};
+
+// Output styles available for drawing the illumination bar
+enum illumination_render_mode {
+    RENDER_SHADE_GLYPHS,   // Bar length and shade glyph convey intensity
+    RENDER_TRUECOLOR,      // Full-width bar whose 24-bit background color conveys intensity
+    RENDER_PWM_SHADE,      // Full-width bar toggled between adjacent shade glyphs to approximate intensity
+    RENDER_ORDERED_DITHER, // Full-screen area mixing shade glyphs through an 8x8 Bayer matrix
+    RENDER_HALF_BLOCK_BEAM, // Flashlight beam at 1x2 sub-cell resolution with colored half blocks
+    RENDER_BRAILLE_BEAM,   // Flashlight beam at 2x4 sub-cell resolution with dithered braille dots
+    RENDER_PALETTE_256     // Full-width bar colored from the xterm 256-color palette
+};
+
+// Output features of the attached terminal, detected from the environment
+struct terminal_capabilities {
+    bool supports_truecolor = false;       // COLORTERM advertises 24-bit color
+    bool supports_256_color = false;       // TERM advertises the xterm 256-color palette
+    bool supports_utf8 = false;            // The locale encodes output as UTF-8
+    int screen_columns = 80;               // Terminal width in character cells
+    int screen_rows = 24;                  // Terminal height in character cells
+};
+
+// One output glyph stored as its complete UTF-8 byte sequence
+struct illumination_glyph {
+    char bytes[4];                         // UTF-8 encoding, unused bytes are zero
+    int byte_count;                        // Number of meaningful bytes (1 to 4)
+};
+
+// Coverage levels of the shade glyphs, each step representing 25 percent intensity
+enum shade_glyph_level {
+    GLYPH_BLANK = 0,
+    GLYPH_LIGHT_SHADE = 1,
+    GLYPH_MEDIUM_SHADE = 2,
+    GLYPH_DARK_SHADE = 3,
+    GLYPH_FULL_BLOCK = 4
+};
+
+// This function encodes a Unicode code point as a UTF-8 glyph at compile time
+constexpr illumination_glyph encode_utf8_glyph(char32_t code_point) {
+    illumination_glyph glyph{{0, 0, 0, 0}, 0};
+    if (code_point < 0x80) {
+        glyph.bytes[0] = static_cast<char>(code_point);
+        glyph.byte_count = 1;
+    } else if (code_point < 0x800) {
+        glyph.bytes[0] = static_cast<char>(0xC0 | (code_point >> 6));
+        glyph.bytes[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+        glyph.byte_count = 2;
+    } else if (code_point < 0x10000) {
+        glyph.bytes[0] = static_cast<char>(0xE0 | (code_point >> 12));
+        glyph.bytes[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        glyph.bytes[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+        glyph.byte_count = 3;
+    } else {
+        glyph.bytes[0] = static_cast<char>(0xF0 | (code_point >> 18));
+        glyph.bytes[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        glyph.bytes[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        glyph.bytes[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+        glyph.byte_count = 4;
+    }
+    return glyph;
+}
+
+// This function compares a glyph against an expected byte sequence at compile time
+constexpr bool glyph_bytes_equal(const illumination_glyph& glyph, const char* expected_bytes, int expected_count) {
+    if (glyph.byte_count != expected_count) {
+        return false;
+    }
+    for (int byte_index = 0; byte_index < expected_count; byte_index++) {
+        if (glyph.bytes[byte_index] != expected_bytes[byte_index]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Shade glyphs by coverage level for UTF-8 terminals
+constexpr illumination_glyph utf8_shade_glyphs[5] = {
+    encode_utf8_glyph(U' '),
+    encode_utf8_glyph(U'░'),
+    encode_utf8_glyph(U'▒'),
+    encode_utf8_glyph(U'▓'),
+    encode_utf8_glyph(U'█'),
+};
+
+// Single-byte stand-ins with increasing ink coverage for terminals without UTF-8
+constexpr illumination_glyph ascii_shade_glyphs[5] = {
+    encode_utf8_glyph(U' '),
+    encode_utf8_glyph(U'.'),
+    encode_utf8_glyph(U':'),
+    encode_utf8_glyph(U'%'),
+    encode_utf8_glyph(U'#'),
+};
+
+// The exact bytes written to the terminal for every glyph
+static_assert(glyph_bytes_equal(utf8_shade_glyphs[GLYPH_BLANK], " ", 1), "Blank must be a single space");
+static_assert(glyph_bytes_equal(utf8_shade_glyphs[GLYPH_LIGHT_SHADE], "\xE2\x96\x91", 3), "U+2591 LIGHT SHADE");
+static_assert(glyph_bytes_equal(utf8_shade_glyphs[GLYPH_MEDIUM_SHADE], "\xE2\x96\x92", 3), "U+2592 MEDIUM SHADE");
+static_assert(glyph_bytes_equal(utf8_shade_glyphs[GLYPH_DARK_SHADE], "\xE2\x96\x93", 3), "U+2593 DARK SHADE");
+static_assert(glyph_bytes_equal(utf8_shade_glyphs[GLYPH_FULL_BLOCK], "\xE2\x96\x88", 3), "U+2588 FULL BLOCK");
+static_assert(glyph_bytes_equal(encode_utf8_glyph(U'▀'), "\xE2\x96\x80", 3), "U+2580 UPPER HALF BLOCK");
+static_assert(glyph_bytes_equal(encode_utf8_glyph(U'\u2800'), "\xE2\xA0\x80", 3), "U+2800 BRAILLE BLANK");
+static_assert(glyph_bytes_equal(ascii_shade_glyphs[GLYPH_FULL_BLOCK], "#", 1), "ASCII fallback must be one byte");
+
+// One published light frame guarded by its own sequence counter (seqlock)
+struct alignas(32) light_frame_ring_slot {
+    atomic<uint64_t> sequence;               // Odd while being written, 2 * frame number + 2 once complete
+    atomic<long long> timestamp_nanoseconds; // CLOCK_MONOTONIC time the frame was rendered
+    atomic<uint32_t> intensity_level;        // Intensity percentage of the frame
+    atomic<uint32_t> pattern_id;             // illumination_pattern_id of the frame
+};
+
+// Layout of the shared-memory ring other local processes poll for the current light state
+struct light_frame_ring {
+    atomic<uint32_t> ring_magic;                        // LIGHT_FRAME_RING_MAGIC once the header is valid
+    atomic<uint32_t> publisher_active;                  // Cleared when the publishing instance finishes
+    int32_t publisher_process;                          // Process that created the ring and writes its frames
+    alignas(64) atomic<uint64_t> published_frames;      // Total frames published so far
+    alignas(64) light_frame_ring_slot slots[LIGHT_FRAME_RING_CAPACITY];
+};
+
+// One frame as copied out of the ring by a reader
+struct light_frame_snapshot {
+    uint64_t frame_number;
+    long long timestamp_nanoseconds;
+    uint32_t intensity_level;
+    uint32_t pattern_id;
+};
+
+// Outcome of a single lock-free read attempt on one ring slot
+enum light_frame_read_result {
+    LIGHT_FRAME_READ,
+    LIGHT_FRAME_NOT_READY,
+    LIGHT_FRAME_OVERWRITTEN
+};
+
+// Launch options collected from the command line before the operational sequence starts
+struct flashlight_launch_options {
+    vector<string> broadcast_device_paths; // Additional terminals, ptys or pipes mirroring the light
+    string synchronized_pattern_name;      // Pattern played in cross-process synchronized mode, empty when off
+    string synchronized_segment_name = "/artlest_flashlight_sync"; // Shared-memory clock segment name
+    int synchronized_cycle_count = 5;      // Number of pattern cycles played in synchronized mode
+    int phase_test_instance_count = 0;     // Instances spawned by the synchronized phase error test
+    bool publish_frame_ring = false;       // Publish every frame into the shared-memory frame ring
+    bool monitor_frame_ring = false;       // Run the reference reader instead of the flashlight
+    string frame_ring_name = "/artlest_flashlight_frames"; // Shared-memory frame ring segment name
+    int frame_ring_benchmark_seconds = 0;  // Duration of the 1 kHz ring throughput benchmark
+    string render_mode_name = "auto";      // Requested renderer name, see display_command_line_usage
+    int ramp_frames_per_second = 120;      // Frame rate of brightness ramps
+    int pwm_frequency_hertz = 50;          // Toggle frequency of the PWM shade renderer
+    bool dither_benchmark = false;         // Benchmark the ordered-dither renderer on a 400x120 screen
+    bool beam_benchmark = false;           // Benchmark the beam renderers on a 400x120 screen
+    bool force_ascii_glyphs = false;       // Use the ASCII glyph fallback even on UTF-8 terminals
+    bool row_fill_benchmark = false;       // Compare glyph row fill strategies for wide terminals
+    bool allocation_check = false;         // Fail if the built-in sequence performs any heap allocation
+    int program_benchmark_edges = 0;       // Edge count of the arena compile benchmark program
+    int status_format_benchmark_seconds = 0; // Duration of the 1 kHz status formatting benchmark
+    string light_program_name;             // Built-in light program name or bytecode assembly file
+    bool light_vm_benchmark = false;       // Measure bytecode dispatch rate and edge emission latency
+    bool compaction_report = false;        // Report the edge reduction of the compacted four-phase sequence
+    long long start_offset_microseconds = -1; // Play the compiled four-phase sequence from this offset
+    int seek_benchmark_edges = 0;          // Edge count of the timeline seek benchmark program
+    int pause_test_count = 0;              // Pauses taken mid-flash by the pause/resume test
+    double playback_speed_factor = 1.0;    // Timeline speed of compiled and bytecode playback, 0.1 to 100
+    int spin_wait_microseconds = 2000;     // Waits shorter than this are spun instead of slept
+    int spin_margin_microseconds = 150;    // Longer waits sleep until this long before the deadline, then spin
+    bool waiter_benchmark = false;         // Measure lateness and CPU cost of sleep, hybrid and spin waits
+    bool realtime_timing = false;          // Run the timing thread under SCHED_FIFO, pinned, locked and with low slack
+    int realtime_priority = 50;            // SCHED_FIFO priority of the timing thread, 1 to 99
+    int timing_cpu = -1;                   // CPU the timing thread is pinned to, or -1 for the last one
+    int realtime_stress_seconds = 0;       // Seconds per phase of the real-time jitter stress test
+    string control_socket_path;            // Unix datagram socket accepting stop and status commands
+    int event_loop_benchmark_seconds = 0;  // Length of the continuous illumination event loop benchmark
+    string beacon_pattern_name;            // Beacon pattern: steady or a synchronized pattern name
+    double beacon_hours = 0.0;             // Beacon run length, or 0 to run until stopped
+    int beacon_report_minutes = 60;        // Interval between beacon status reports
+    int beacon_benchmark_seconds = 0;      // Length of each run of the beacon wakeup benchmark
+    bool speed_benchmark = false;          // Measure edge accuracy of the sequence at high speed factors
+};
+
+// One additional output descriptor receiving a copy of every rendered illumination frame
+struct broadcast_sink {
+    string device_path;                              // Path supplied with --broadcast
+    int file_descriptor = -1;                        // Non-blocking descriptor opened for writing
+    string in_flight_frame;                          // Frame currently being written to the descriptor
+    size_t in_flight_offset = 0;                     // Bytes of the in-flight frame already written
+    steady_clock::time_point in_flight_rendered_at;  // Render time of the in-flight frame
+    string queued_frame;                             // Newest frame waiting behind the in-flight one
+    steady_clock::time_point queued_rendered_at;     // Render time of the queued frame
+    bool queued_frame_present = false;               // Whether queued_frame holds an undelivered frame
+    bool write_interest_registered = false;          // Whether EPOLLOUT is currently armed for the descriptor
+    bool sink_failed = false;                        // Set once the descriptor reports an error or hangup
+    long long frames_delivered = 0;                  // Frames written completely to this sink
+    long long frames_superseded = 0;                 // Frames replaced by a newer one before being written
+    long long total_lag_microseconds = 0;            // Sum of render-to-delivery lag over delivered frames
+    long long maximum_lag_microseconds = 0;          // Worst render-to-delivery lag observed
+};
+
+// Shared state of the fan-out writer: the sinks, the epoll loop and its wakeup descriptor
+struct frame_broadcast_hub {
+    vector<broadcast_sink> sinks;
+    mutex sink_mutex;
+    int epoll_descriptor = -1;
+    int wakeup_descriptor = -1;
+    thread writer_thread;
+    atomic<bool> shutdown_requested{false};
+    bool active = false;
+};
+
+// Scratch buffers reused by every frame so steady-state playback never touches the heap
+struct illumination_render_workspace {
+    string illumination_frame;             // Bytes of the frame currently being composed
+    string screen_frame;                   // Output of the full-screen renderers (dither, beam)
+    vector<uint8_t> intensity_field;       // Per-pixel intensities for the full-screen renderers
+    vector<uint8_t> glyph_levels;          // One quantized row of the ordered dither
+    string pwm_lower_frame;                // Prerendered lower-level bar of a PWM hold
+    string pwm_upper_frame;                // Prerendered upper-level bar of a PWM hold
+};
+
+// One step of a light program: a repeating cycle played a number of times
+struct light_program_step {
+    const synchronized_cycle* cycle;    // Cycle whose edges are expanded
+    int repeat_count;                   // Number of consecutive repetitions of the cycle
+};
+
+// A light program expanded into one flat timeline plus the rendered frame of every light state it uses
+struct compiled_light_program {
+    explicit compiled_light_program(pmr::memory_resource* session_resource)
+        : edges(session_resource), state_frames(session_resource) {}
+    
+    pmr::vector<timeline_edge> edges;       // Every edge of the program at its absolute offset
+    pmr::vector<pmr::string> state_frames;  // Frame bytes indexed by pattern * 101 + intensity
+    long long duration_microseconds = 0;    // Offset at which the program ends
+};
+
+// A playback session whose arena owns every edge and frame; destroying it releases them in one shot
+struct light_program_session {
+    explicit light_program_session(size_t arena_size_hint)
+        : arena(arena_size_hint), program(&arena) {}
+    
+    pmr::monotonic_buffer_resource arena;
+    compiled_light_program program;
+};
+
+// A block of compacted edges that is played a number of times back to back
+struct timeline_run {
+    size_t first_edge;                  // Index of the block's first edge in the compacted edge list
+    size_t edge_count;                  // Edges in one repetition of the block
+    int repeat_count;                   // Consecutive repetitions; 1 for edges that do not repeat
+    long long period_microseconds;      // Distance between the starts of consecutive repetitions
+};
+
+// A compiled timeline without redundant edges, in which every repeated block is stored only once
+struct compacted_light_timeline {
+    explicit compacted_light_timeline(pmr::memory_resource* session_resource)
+        : edges(session_resource), runs(session_resource) {}
+    
+    pmr::vector<timeline_edge> edges;       // First repetition of every run, at absolute offsets
+    pmr::vector<timeline_run> runs;         // Runs in timeline order, covering every edge
+    long long duration_microseconds = 0;    // Offset at which the program ends
+};
+
+// Edge counts after each stage of the timeline compaction pass
+struct timeline_compaction_report {
+    size_t compiled_edges = 0;              // Edges before compaction
+    size_t zero_length_segments_folded = 0; // Edges replaced at the same instant they were shown
+    size_t equal_states_merged = 0;         // Edges redrawing the state already shown
+    size_t flat_edges = 0;                  // Edges left after folding and merging
+    size_t stored_edges = 0;                // Edges stored once repeated blocks are hoisted into runs
+    size_t run_count = 0;                   // Runs covering the compacted timeline
+    size_t repeated_blocks = 0;             // Runs played more than once
+};
+
+// Edges between consecutive samples of a timeline time index
+constexpr size_t TIMELINE_INDEX_STRIDE = 64;
+
+// Sparse index over a timeline: the offset of every TIMELINE_INDEX_STRIDE-th edge, packed densely so a
+// seek binary-searches a small array first and then only one stride of the edge list itself
+struct timeline_time_index {
+    explicit timeline_time_index(pmr::memory_resource* session_resource)
+        : sampled_offsets(session_resource) {}
+    
+    pmr::vector<long long> sampled_offsets; // Offset of edges 0, stride, 2 * stride, ...
+};
+
+// Pause requests for compiled playback, raised from signal handlers
+struct playback_pause_control {
+    atomic<bool> pause_requested{false};    // Set while playback should be held dark
+    atomic<bool> stop_when_paused{false};   // Ctrl-Z: stop the process once the light is dark
+    int wakeup_descriptor = -1;             // eventfd written on every request to interrupt a wait
+    int timer_descriptor = -1;              // timerfd armed with the next edge deadline
+};
+
+// Light actually shown by a compiled playback, measured at the moments frames were drawn
+struct playback_light_statistics {
+    long long lit_nanoseconds = 0;          // Time any state other than off was shown
+    long long paused_nanoseconds = 0;       // Time spent paused
+    int pause_count = 0;                    // Pauses taken
+    bool light_on = false;                  // Whether the state shown last is lit
+    steady_clock::time_point lit_since;     // When the state shown last was drawn
+};
+
+// Result of seeking a timeline to an offset
+struct timeline_seek_position {
+    size_t edge_index;                      // Edge whose state is in effect at the offset
+    long long segment_elapsed_microseconds; // Time already spent in that edge's segment
+};
+
+// Sources registered with the sequence event loop, stored in each epoll event's data
+enum light_event_source : uint64_t {
+    EVENT_SOURCE_TIMER = 0,                 // timerfd armed at the next deadline
+    EVENT_SOURCE_SIGNAL,                    // signalfd for SIGINT, SIGTERM and SIGWINCH
+    EVENT_SOURCE_STDIN,                     // Command lines typed on standard input
+    EVENT_SOURCE_CONTROL                    // Command datagrams on the control socket
+};
+
+// Descriptors and counters of the single-threaded event loop that schedules the flashlight sequence
+struct light_event_loop {
+    int epoll_descriptor = -1;              // Readiness set of every source below, or -1 when not running
+    int timer_descriptor = -1;              // Absolute CLOCK_MONOTONIC deadline timer
+    int signal_descriptor = -1;             // Blocked termination and resize signals
+    int control_descriptor = -1;            // Unix datagram socket bound to --control-socket
+    bool stdin_registered = false;          // Standard input can still deliver command lines
+    bool stop_requested = false;            // A stop command or termination signal arrived
+    char pending_input[256] = {};           // Partial command line read from standard input
+    size_t pending_input_length = 0;        // Bytes of pending_input in use; longer lines are truncated
+    long long wakeups = 0;                  // Returns from epoll_wait
+    long long timer_expirations = 0;        // Deadlines reached through the timerfd
+    long long commands_handled = 0;         // Commands from standard input and the control socket
+    long long signals_handled = 0;          // Signals read from the signalfd
+};
+
+// Lateness allowed for a beacon status report so it can share the wakeup of the next light edge
+constexpr long long BEACON_REPORT_COALESCING_MICROSECONDS = 60000000;
+
+// Longest timed beacon run (one year); --beacon-hours is clamped to it so the run length stays far
+// inside the range of steady_clock time points
+constexpr double BEACON_MAXIMUM_HOURS = 8760.0;
+
+// Largest --start-at accepted while parsing; the compiled sequence then rejects offsets past its own end
+constexpr double START_OFFSET_MAXIMUM_SECONDS = 86400.0;
+
+// Counters of one beacon run
+struct beacon_run_statistics {
+    steady_clock::time_point started;       // When the beacon lit
+    long long cpu_start_microseconds = 0;   // Process CPU time when the beacon lit
+    long long wakeups_at_start = 0;         // Event loop wakeups before the beacon lit
+    long long edges_shown = 0;              // Light edges drawn
+    long long reports_written = 0;          // Status reports printed
+    long long reports_coalesced = 0;        // Reports that shared the wakeup of a light edge
+    frame_pacing_statistics edge_pacing;    // Wake-up lateness of every light edge
+};
+
+// Which parts of the real-time mode took effect on the timing thread
+struct realtime_timing_report {
+    bool fifo_applied = false;              // Thread runs under SCHED_FIFO
+    int fifo_priority = 0;                  // Requested SCHED_FIFO priority
+    bool affinity_applied = false;          // Thread is pinned to timing_cpu
+    int timing_cpu = -1;                    // CPU the thread was pinned to
+    bool memory_locked = false;             // mlockall succeeded
+    bool future_pages_locked = false;       // Pages mapped later are locked as well
+    bool timer_slack_reduced = false;       // Timer slack lowered to 1 ns
+};
+
+// Operations of the light program bytecode
+enum light_opcode : uint8_t {
+    LIGHT_OP_HALT = 0,                  // Stop the program
+    LIGHT_OP_SET,                       // register = immediate
+    LIGHT_OP_ADD,                       // register += immediate, saturating at the int32 limits
+    LIGHT_OP_EMIT,                      // Show pattern operand at intensity immediate
+    LIGHT_OP_EMIT_REGISTER,             // Show pattern operand at the intensity held in register
+    LIGHT_OP_WAIT,                      // Advance the program clock by immediate microseconds
+    LIGHT_OP_WAIT_REGISTER,             // Advance the program clock by register microseconds; negative stops the program
+    LIGHT_OP_JUMP,                      // Continue at instruction operand
+    LIGHT_OP_LOOP,                      // Decrement register; continue at operand while it is non-zero
+    LIGHT_OP_JUMP_IF_LESS,              // Continue at operand when register < immediate
+    LIGHT_OP_REPEAT_UNTIL_STOPPED,      // Continue at operand unless a stop was requested
+    LIGHT_OPCODE_COUNT
+};
+
+constexpr int LIGHT_VM_REGISTER_COUNT = 8;
+
+// One fixed-width bytecode instruction; fields an opcode does not use are zero
+struct light_instruction {
+    light_opcode opcode;
+    uint8_t register_index;             // Register operand
+    uint16_t operand;                   // Jump target, or the pattern id of an emit
+    int32_t immediate;                  // Value, intensity or microseconds
+};
+
+static_assert(sizeof(light_instruction) == 8, "light instructions must stay 8 bytes wide");
+
+// Execution state of one light program; time is virtual and advanced only by wait instructions
+struct light_vm_state {
+    int32_t registers[LIGHT_VM_REGISTER_COUNT] = {};
+    size_t program_counter = 0;
+    long long timeline_microseconds = 0;    // Program clock: sum of all waits executed so far
+    long long instructions_executed = 0;
+    long long edges_emitted = 0;
+    bool negative_wait_rejected = false;    // A register wait held a negative duration and stopped the program
+};
+
+// Fixed-capacity text buffer that formats status counters with to_chars instead of stream insertion
+struct status_text_buffer {
+    char text[512];                     // Formatted bytes; never heap allocated
+    size_t length = 0;                  // Bytes used in text
+    
+    // Appends a NUL-terminated fragment, truncating once the buffer is full
+    void append_text(const char* fragment) {
+        size_t fragment_length = min(strlen(fragment), sizeof(text) - length);
+        memcpy(text + length, fragment, fragment_length);
+        length += fragment_length;
+    }
+    
+    // Appends a decimal integer without consulting the locale or any stream state
+    void append_number(long long value) {
+        to_chars_result result = to_chars(text + length, text + sizeof(text), value);
+        if (result.ec == errc()) {
+            length = static_cast<size_t>(result.ptr - text);
+        }
+    }
+};
+
 // Function prototype declarations for modular program architecture
 void display_program_header();
 void initialize_flashlight_system();
@@ -25,202 +834,597 @@ void execute_strobe_light_pattern(int flash_count, int interval_milliseconds);
 void execute_emergency_signal_pattern();
 void execute_brightness_level_demonstration();
 void clear_console_screen();
-void generate_illumination_pattern(string pattern_type, int intensity_level);
-void display_operational_status(string mode_description, int power_level);
+void generate_illumination_pattern(illumination_pattern_id pattern, int intensity_level);
+void display_operational_status(const char* mode_description, int power_level);
 void process_flashlight_operations();
 void display_program_termination();
+bool parse_command_line_options(int argc, char* argv[]);
+void display_command_line_usage(const char* program_name);
+bool initialize_frame_broadcast(const vector<string>& device_paths);
+void publish_frame_to_broadcast_sinks(const string& frame_bytes);
+void run_broadcast_event_loop();
+void shutdown_frame_broadcast();
+void display_broadcast_statistics();
+void wait_until_absolute_deadline(steady_clock::time_point deadline);
+const char* illumination_pattern_name(illumination_pattern_id pattern);
+const synchronized_cycle* find_synchronized_cycle(const string& pattern_name);
+const synchronized_cycle* find_synchronized_cycle(illumination_pattern_id pattern);
+synchronized_clock_segment* attach_synchronized_clock(const string& segment_name, const synchronized_cycle& requested_cycle);
+void execute_synchronized_pattern_mode(vector<long long>* edge_timestamps);
+int execute_synchronized_phase_test(int instance_count);
+light_frame_ring* open_light_frame_ring(const string& ring_name, bool create_ring);
+void close_light_frame_ring(const string& ring_name, light_frame_ring* ring);
+void publish_light_frame(light_frame_ring* ring, long long timestamp_nanoseconds,
+                         uint32_t intensity_level, uint32_t pattern_id);
+light_frame_read_result read_light_frame(const light_frame_ring* ring, uint64_t frame_number,
+                                         light_frame_snapshot& snapshot);
+int execute_frame_ring_monitor();
+int execute_frame_ring_benchmark(int duration_seconds);
+terminal_capabilities detect_terminal_capabilities();
+bool select_illumination_render_mode(const string& render_mode_name, const terminal_capabilities& capabilities);
+void initialize_truecolor_escape_table();
+void append_truecolor_illumination_bar(string& illumination_frame, int intensity_level);
+int evaluate_ramp_curve(brightness_ramp_curve curve, uint32_t progress_q16);
+int compute_ramp_frame_intensity(int start_intensity, int end_intensity, long long frame_index, long long frame_count,
+                                 brightness_ramp_curve curve);
+void execute_brightness_ramp(int start_intensity, int end_intensity, milliseconds ramp_duration,
+                             brightness_ramp_curve curve, frame_pacing_statistics& pacing_statistics);
+void display_frame_pacing_statistics(const frame_pacing_statistics& pacing_statistics, int frames_per_second);
+void emit_illumination_frame(const string& illumination_frame, illumination_pattern_id pattern, int intensity_level);
+void append_pwm_shade_bar(string& illumination_frame, int glyph_level, int intensity_level);
+pwm_duty_statistics execute_pwm_dithered_hold(int intensity_level, milliseconds hold_duration);
+void display_pwm_duty_statistics(const pwm_duty_statistics* duty_statistics, int hold_count);
+void compute_ordered_dither_levels(const uint8_t* intensity_row, int row_index, int columns, uint8_t* glyph_levels);
+void render_ordered_dither_frame(const uint8_t* intensity_field, int columns, int rows, string& dither_frame);
+void append_ordered_dither_screen(string& illumination_frame, int intensity_level);
+int execute_ordered_dither_benchmark();
+void compute_beam_intensity_field(int field_width, int field_height, float aim_angle, float peak_intensity,
+                                  uint8_t* intensity_field);
+void render_half_block_beam_frame(const uint8_t* intensity_field, int columns, int rows, bool palette_output,
+                                  string& beam_frame);
+void render_braille_beam_frame(const uint8_t* intensity_field, int columns, int rows, string& beam_frame);
+void append_beam_screen(string& illumination_frame, int intensity_level);
+int execute_beam_render_benchmark();
+void initialize_xterm_palette_tables();
+uint8_t quantize_to_xterm_palette(uint8_t red, uint8_t green, uint8_t blue);
+void append_palette_illumination_bar(string& illumination_frame, int intensity_level);
+void replicate_glyph_to_width(string& illumination_frame, const illumination_glyph& glyph, int cell_count);
+void fill_glyph_row(char* row_bytes, const illumination_glyph& glyph, int cell_count);
+void fill_glyph_row_by_doubling(char* row_bytes, const illumination_glyph& glyph, int cell_count);
+int execute_row_fill_benchmark();
+void prepare_render_workspace();
+int execute_allocation_free_sequence_check();
+void append_shade_illumination_bar(string& illumination_frame, illumination_pattern_id pattern, int intensity_level);
+void append_intensity_label(string& illumination_frame, int intensity_level);
+void write_status_text(const status_text_buffer& status_text);
+int execute_status_format_benchmark(int duration_seconds);
+bool validate_light_program(const light_instruction* program, size_t instruction_count);
+bool load_light_program_file(const string& file_path, vector<light_instruction>& program);
+bool select_light_program(const string& program_name);
+void run_light_program(const light_instruction* program, light_vm_state& state,
+                       pmr::vector<timeline_edge>* recorded_edges, frame_pacing_statistics* emission_statistics);
+void execute_light_program_mode();
+int execute_light_vm_benchmark();
+void compile_light_program(const light_program_step* steps, int step_count, compiled_light_program& program);
+int execute_program_arena_benchmark(int edge_count);
+void compact_light_program(const compiled_light_program& program, compacted_light_timeline& compacted,
+                           timeline_compaction_report& report);
+void expand_compacted_timeline(const compacted_light_timeline& compacted, pmr::vector<timeline_edge>& edges);
+void compile_four_phase_sequence(compiled_light_program& program);
+int execute_timeline_compaction_report();
+void build_timeline_time_index(const timeline_edge* edges, size_t edge_count, timeline_time_index& time_index);
+timeline_seek_position seek_timeline(const timeline_edge* edges, size_t edge_count, const timeline_time_index& time_index,
+                                     long long offset_microseconds);
+void play_compiled_program(const compiled_light_program& program, const timeline_time_index& time_index,
+                           long long start_offset_microseconds, frame_pacing_statistics* emission_statistics,
+                           playback_light_statistics* light_statistics);
+void install_playback_pause_handlers();
+void remove_playback_pause_handlers();
+void execute_compiled_sequence_mode();
+int execute_timeline_seek_benchmark(int edge_count);
+int execute_pause_resume_test(int pause_count);
+void scale_compiled_program(compiled_light_program& program, double speed_factor);
+long long scale_program_time(long long program_microseconds);
+int execute_playback_speed_benchmark();
+void record_frame_lateness(frame_pacing_statistics& pacing_statistics, long long lateness_nanoseconds);
+long long lateness_percentile_microseconds(const frame_pacing_statistics& pacing_statistics, double fraction);
+int execute_deadline_waiter_benchmark();
+void apply_realtime_timing(realtime_timing_report& timing_report);
+int execute_realtime_jitter_stress_test(int phase_seconds);
+bool initialize_light_event_loop();
+void shutdown_light_event_loop();
+bool wait_in_light_event_loop(steady_clock::time_point deadline);
+int execute_event_loop_benchmark(int duration_seconds);
+int execute_beacon_mode();
+int execute_beacon_benchmark(int duration_seconds);
+
+flashlight_launch_options launch_options;
+frame_broadcast_hub broadcast_hub;
+light_frame_ring* published_frame_ring = nullptr;
+illumination_render_mode active_render_mode = RENDER_SHADE_GLYPHS;
+array<string, 101> truecolor_escape_sequences; // Background color escape per intensity percentage
+array<string, 101> truecolor_foreground_escape_sequences; // Foreground color escape per intensity percentage
+terminal_capabilities detected_terminal;
+bool half_block_palette_output = false;        // Half-block beam falls back to the 256-color palette
+array<uint8_t, 32768> xterm_palette_lookup;    // Nearest palette index for every 5-bit-per-channel color
+array<uint8_t, 101> palette_intensity_levels;  // Palette index for every intensity percentage
+array<string, 256> palette_foreground_escape_sequences; // Foreground escape per palette index
+array<string, 256> palette_background_escape_sequences; // Background escape per palette index
+const illumination_glyph* active_shade_glyphs = utf8_shade_glyphs; // Glyph set chosen by the terminal detector
+illumination_render_workspace render_workspace;
+light_event_loop sequence_event_loop;          // Scheduler of the built-in four-phase sequence
+const string status_separator_line(70, '-');   // Built before main so status blocks never allocate
+atomic<bool> heap_allocation_counting{false};  // Enables counting in the replaced operator new
+atomic<long long> counted_heap_allocations{0}; // Allocations observed while counting was enabled
+
+// Replacement global allocation functions that can count every heap allocation in the process
+void* operator new(size_t byte_count) {
+    if (heap_allocation_counting.load(memory_order_relaxed)) {
+        counted_heap_allocations.fetch_add(1, memory_order_relaxed);
+    }
+    void* allocation = malloc(byte_count == 0 ? 1 : byte_count);
+    if (allocation == nullptr) {
+        throw bad_alloc();
+    }
+    return allocation;
+}
+
+void* operator new[](size_t byte_count) {
+    return operator new(byte_count);
+}
+
+void* operator new(size_t byte_count, const nothrow_t&) noexcept {
+    try {
+        return operator new(byte_count);
+    } catch (const bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t byte_count, const nothrow_t&) noexcept {
+    return operator new(byte_count, nothrow);
+}
+
+// Kept out of line so the optimizer never pairs an inlined free with the replaced operator new
+[[gnu::noinline]] void operator delete(void* allocation) noexcept { free(allocation); }
+void operator delete[](void* allocation) noexcept { operator delete(allocation); }
+void operator delete(void* allocation, size_t) noexcept { operator delete(allocation); }
+void operator delete[](void* allocation, size_t) noexcept { operator delete(allocation); }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Parse command line options before any output is produced
+    if (!parse_command_line_options(argc, argv)) {
+        display_command_line_usage(argv[0]);
+        return 1;
+    }
+    
+    // Open broadcast sinks so every rendered frame is mirrored to the requested terminals
+    if (!launch_options.broadcast_device_paths.empty() &&
+        !initialize_frame_broadcast(launch_options.broadcast_device_paths)) {
+        return 1;
+    }
+    
+    // The stress test applies real-time scheduling to its own measuring thread only
+    if (launch_options.realtime_stress_seconds > 0) {
+        return execute_realtime_jitter_stress_test(launch_options.realtime_stress_seconds);
+    }
+    
+    // Real-time scheduling covers this thread, which does all the timing; the broadcast writer started
+    // above keeps normal scheduling, while children of the phase test inherit it
+    if (launch_options.realtime_timing) {
+        realtime_timing_report timing_report;
+        apply_realtime_timing(timing_report);
+    }
+    
+    // The phase error test only coordinates child instances and produces its own report
+    if (launch_options.phase_test_instance_count > 0) {
+        return execute_synchronized_phase_test(launch_options.phase_test_instance_count);
+    }
+    
+    // The reference reader and the benchmarks replace the flashlight sequence entirely
+    if (launch_options.monitor_frame_ring) {
+        return execute_frame_ring_monitor();
+    }
+    if (launch_options.frame_ring_benchmark_seconds > 0) {
+        return execute_frame_ring_benchmark(launch_options.frame_ring_benchmark_seconds);
+    }
+    if (launch_options.dither_benchmark) {
+        return execute_ordered_dither_benchmark();
+    }
+    if (launch_options.beam_benchmark) {
+        return execute_beam_render_benchmark();
+    }
+    if (launch_options.row_fill_benchmark) {
+        return execute_row_fill_benchmark();
+    }
+    if (launch_options.program_benchmark_edges > 0) {
+        return execute_program_arena_benchmark(launch_options.program_benchmark_edges);
+    }
+    if (launch_options.status_format_benchmark_seconds > 0) {
+        return execute_status_format_benchmark(launch_options.status_format_benchmark_seconds);
+    }
+    if (launch_options.compaction_report) {
+        return execute_timeline_compaction_report();
+    }
+    if (launch_options.seek_benchmark_edges > 0) {
+        return execute_timeline_seek_benchmark(launch_options.seek_benchmark_edges);
+    }
+    if (launch_options.pause_test_count > 0) {
+        return execute_pause_resume_test(launch_options.pause_test_count);
+    }
+    if (launch_options.speed_benchmark) {
+        return execute_playback_speed_benchmark();
+    }
+    if (launch_options.waiter_benchmark) {
+        return execute_deadline_waiter_benchmark();
+    }
+    
+    // Choose the renderer from the request and what the terminal supports, then prebuild its tables
+    detected_terminal = detect_terminal_capabilities();
+    if (!select_illumination_render_mode(launch_options.render_mode_name, detected_terminal)) {
+        display_command_line_usage(argv[0]);
+        return 1;
+    }
+    if (!detected_terminal.supports_utf8 || launch_options.force_ascii_glyphs) {
+        // Half blocks and braille have no ASCII form; their light is shown as an ASCII dither instead
+        active_shade_glyphs = ascii_shade_glyphs;
+        if (active_render_mode == RENDER_HALF_BLOCK_BEAM || active_render_mode == RENDER_BRAILLE_BEAM) {
+            active_render_mode = RENDER_ORDERED_DITHER;
+        }
+    }
+    half_block_palette_output = active_render_mode == RENDER_HALF_BLOCK_BEAM &&
+                                !detected_terminal.supports_truecolor && detected_terminal.supports_256_color;
+    if (active_render_mode == RENDER_TRUECOLOR || active_render_mode == RENDER_HALF_BLOCK_BEAM) {
+        initialize_truecolor_escape_table();
+    }
+    if (active_render_mode == RENDER_PALETTE_256 || half_block_palette_output) {
+        initialize_xterm_palette_tables();
+    }
+    prepare_render_workspace();
+    
+    // Create the frame ring so local monitoring tools can follow the light state
+    if (launch_options.publish_frame_ring) {
+        published_frame_ring = open_light_frame_ring(launch_options.frame_ring_name, true);
+        if (published_frame_ring == nullptr) {
+            return 1;
+        }
+    }
+    
+    // The allocation check plays the built-in sequence under the counting allocator and reports the count
+    if (launch_options.allocation_check) {
+        return execute_allocation_free_sequence_check();
+    }
+    if (launch_options.light_vm_benchmark) {
+        return execute_light_vm_benchmark();
+    }
+    if (launch_options.event_loop_benchmark_seconds > 0) {
+        return execute_event_loop_benchmark(launch_options.event_loop_benchmark_seconds);
+    }
+    if (launch_options.beacon_benchmark_seconds > 0) {
+        return execute_beacon_benchmark(launch_options.beacon_benchmark_seconds);
+    }
+    if (!launch_options.beacon_pattern_name.empty()) {
+        return execute_beacon_mode();
+    }
+    
+    // The built-in sequence runs on the event loop, which also takes commands and termination signals
+    bool built_in_sequence = launch_options.synchronized_pattern_name.empty() && launch_options.light_program_name.empty() &&
+                             launch_options.start_offset_microseconds < 0 && launch_options.playback_speed_factor == 1.0;
+    if (built_in_sequence && !initialize_light_event_loop()) {
+        return 1;
+    }
+    if (!built_in_sequence && !launch_options.control_socket_path.empty()) {
+        console_error << "--control-socket is ignored: --sync, --light-program, --start-at and --speed playback"
+                      << " keep their own waits and do not run on the event loop" << end_line;
+    }
+    
     // Display the program identification header with application specifications
     display_program_header();
     
     // Initialize the flashlight system parameters and operational settings
     initialize_flashlight_system();
     
-    // Execute the main flashlight operational sequence
-    process_flashlight_operations();
+    // Execute the main flashlight operational sequence, the shared-timeline pattern when synchronized,
+    // a bytecode light program when one was requested, or the compiled sequence for a start offset or speed
+    if (!launch_options.synchronized_pattern_name.empty()) {
+        execute_synchronized_pattern_mode(nullptr);
+    } else if (!launch_options.light_program_name.empty()) {
+        execute_light_program_mode();
+    } else if (launch_options.start_offset_microseconds >= 0 || launch_options.playback_speed_factor != 1.0) {
+        execute_compiled_sequence_mode();
+    } else {
+        process_flashlight_operations();
+        shutdown_light_event_loop();
+    }
     
     // Display program completion status and termination message
     display_program_termination();
     
+    // Stop the writer and close broadcast sinks, then report how far each one lagged behind
+    if (broadcast_hub.active) {
+        shutdown_frame_broadcast();
+        display_broadcast_statistics();
+    }
+    
+    // Tell ring readers that no further frames will follow and remove the ring's name
+    if (published_frame_ring != nullptr) {
+        close_light_frame_ring(launch_options.frame_ring_name, published_frame_ring);
+        published_frame_ring = nullptr;
+    }
+    
     return 0; // Return success status code to operating system
 }
 
 // This function displays the program header with application specifications
 void display_program_header() {
     clear_console_screen();
-    cout << string(80, '=') << endl;
-    cout << "              PROFESSIONAL CONSOLE FLASHLIGHT APPLICATION" << endl;
-    cout << "                        Active Illumination System" << endl;
-    cout << string(80, '=') << endl;
-    cout << "Application provides console-based illumination, strobe patterns," << endl;
-    cout << "and emergency signaling through dynamic screen brightness control." << endl;
-    cout << string(80, '=') << endl << endl;
+    console_output << string(80, '=') << end_line;
+    console_output << "              PROFESSIONAL CONSOLE FLASHLIGHT APPLICATION" << end_line;
+    console_output << "                        Active Illumination System" << end_line;
+    console_output << string(80, '=') << end_line;
+    console_output << "Application provides console-based illumination, strobe patterns," << end_line;
+    console_output << "and emergency signaling through dynamic screen brightness control." << end_line;
+    console_output << string(80, '=') << end_line << end_line;
 }
 
 // This function initializes the flashlight system parameters and settings
 void initialize_flashlight_system() {
-    cout << "FLASHLIGHT SYSTEM INITIALIZATION:" << endl;
-    cout << "Console Display Engine: Active" << endl;
-    cout << "Illumination Processor: Operational" << endl;
-    cout << "Pattern Generator: Ready" << endl;
-    cout << "Emergency Protocols: Loaded" << endl;
-    cout << "System Status: READY FOR OPERATION" << endl;
-    cout << string(70, '-') << endl << endl;
+    console_output << "FLASHLIGHT SYSTEM INITIALIZATION:" << end_line;
+    console_output << "Console Display Engine: Active" << end_line;
+    console_output << "Illumination Processor: Operational" << end_line;
+    console_output << "Pattern Generator: Ready" << end_line;
+    console_output << "Emergency Protocols: Loaded" << end_line;
+    console_output << "System Status: READY FOR OPERATION" << end_line;
+    console_output << string(70, '-') << end_line << end_line;
     
     // Brief initialization delay for system preparation
-    this_thread::sleep_for(milliseconds(1000));
+    wait_in_light_event_loop(steady_clock::now() + milliseconds(1000));
 }
 
 // This function executes the main flashlight operational sequence
 void process_flashlight_operations() {
-    cout << "INITIATING FLASHLIGHT OPERATION SEQUENCE..." << endl << endl;
+    console_output << "INITIATING FLASHLIGHT OPERATION SEQUENCE..." << end_line << end_line;
     
     // Execute continuous illumination mode for standard lighting
-    cout << "Phase 1: Continuous Illumination Mode" << endl;
+    console_output << "Phase 1: Continuous Illumination Mode" << end_line;
     execute_continuous_illumination_mode(3);
     
     // Execute strobe light pattern for attention-getting functionality
-    cout << "\nPhase 2: Strobe Light Pattern" << endl;
-    execute_strobe_light_pattern(8, 500);
+    if (!sequence_event_loop.stop_requested) {
+        console_output << "\nPhase 2: Strobe Light Pattern" << end_line;
+        execute_strobe_light_pattern(8, 500);
+    }
     
     // Execute emergency signal pattern for distress situations
-    cout << "\nPhase 3: Emergency Signal Pattern" << endl;
-    execute_emergency_signal_pattern();
+    if (!sequence_event_loop.stop_requested) {
+        console_output << "\nPhase 3: Emergency Signal Pattern" << end_line;
+        execute_emergency_signal_pattern();
+    }
     
     // Execute brightness level demonstration for intensity control
-    cout << "\nPhase 4: Brightness Level Demonstration" << endl;
-    execute_brightness_level_demonstration();
+    if (!sequence_event_loop.stop_requested) {
+        console_output << "\nPhase 4: Brightness Level Demonstration" << end_line;
+        execute_brightness_level_demonstration();
+    }
+    if (sequence_event_loop.stop_requested) {
+        console_output << "\nSequence stopped on request." << end_line;
+    }
 }
 
 // This function implements continuous illumination mode with steady light output
 void execute_continuous_illumination_mode(int duration_seconds) {
     display_operational_status("CONTINUOUS ILLUMINATION", 100);
     
-    // Generate maximum brightness illumination pattern
-    for (int second_counter = 1; second_counter <= duration_seconds; second_counter++) {
-        generate_illumination_pattern("STEADY_BRIGHT", 100);
-        cout << "Illumination Active - Duration: " << second_counter 
-             << "/" << duration_seconds << " seconds" << endl;
-        this_thread::sleep_for(milliseconds(1000));
-    }
+    // The steady light is drawn once and the loop sleeps until the phase ends; only commands, signals or
+    // a stop wake it before then, and the duration is reported once the light has been on for it
+    steady_clock::time_point illumination_start = steady_clock::now();
+    generate_illumination_pattern(PATTERN_STEADY_BRIGHT, 100);
+    wait_in_light_event_loop(illumination_start + seconds(duration_seconds));
+    long long illuminated_seconds = duration_cast<seconds>(steady_clock::now() - illumination_start).count();
+    status_text_buffer narration;
+    narration.append_text("Illumination Active - Duration: ");
+    narration.append_number(min<long long>(illuminated_seconds, duration_seconds));
+    narration.append_text("/");
+    narration.append_number(duration_seconds);
+    narration.append_text(" seconds\n");
+    write_status_text(narration);
     
     // Deactivate illumination and restore normal display
-    generate_illumination_pattern("OFF", 0);
-    cout << "Continuous illumination mode completed." << endl;
+    generate_illumination_pattern(PATTERN_OFF, 0);
+    console_output << "Continuous illumination mode completed." << end_line;
 }
 
 // This function implements strobe light pattern with configurable timing
 void execute_strobe_light_pattern(int flash_count, int interval_milliseconds) {
     display_operational_status("STROBE LIGHT PATTERN", 100);
     
-    // Execute specified number of strobe flashes
+    // The flash comes from the compile-time strobe table; the pause length is chosen by the caller
+    const pattern_segment& flash_segment = strobe_cycle_segments[0];
+    const pattern_segment& pause_segment = strobe_cycle_segments[1];
+    
+    // Execute specified number of strobe flashes; each segment ends a fixed time after the previous one
+    steady_clock::time_point segment_deadline = steady_clock::now();
     for (int flash_counter = 1; flash_counter <= flash_count; flash_counter++) {
         // Generate high-intensity flash
-        generate_illumination_pattern("STROBE_FLASH", 100);
-        cout << "FLASH " << flash_counter << "/" << flash_count << " - HIGH INTENSITY" << endl;
-        this_thread::sleep_for(milliseconds(200));
+        generate_illumination_pattern(flash_segment.pattern, flash_segment.intensity_level);
+        status_text_buffer narration;
+        narration.append_text("FLASH ");
+        narration.append_number(flash_counter);
+        narration.append_text("/");
+        narration.append_number(flash_count);
+        narration.append_text(" - ");
+        narration.append_text(flash_segment.narration);
+        narration.append_text("\n");
+        write_status_text(narration);
+        segment_deadline += microseconds(flash_segment.duration_microseconds);
+        if (!wait_in_light_event_loop(segment_deadline)) {
+            break;
+        }
         
         // Generate off period between flashes
-        generate_illumination_pattern("OFF", 0);
-        cout << "Flash interval pause..." << endl;
-        this_thread::sleep_for(milliseconds(interval_milliseconds));
+        generate_illumination_pattern(pause_segment.pattern, pause_segment.intensity_level);
+        console_output << pause_segment.narration << end_line;
+        segment_deadline += milliseconds(interval_milliseconds);
+        if (!wait_in_light_event_loop(segment_deadline)) {
+            break;
+        }
+    }
+    if (sequence_event_loop.stop_requested) {
+        generate_illumination_pattern(PATTERN_OFF, 0);
     }
     
-    cout << "Strobe light pattern sequence completed." << endl;
+    console_output << "Strobe light pattern sequence completed." << end_line;
 }
 
 // This function implements emergency signal pattern using SOS morse code
 void execute_emergency_signal_pattern() {
     display_operational_status("EMERGENCY SIGNAL - SOS PATTERN", 100);
     
-    // SOS pattern: 3 short, 3 long, 3 short flashes
-    string sos_pattern[] = {"SHORT", "SHORT", "SHORT", "LONG", "LONG", "LONG", "SHORT", "SHORT", "SHORT"};
-    int pattern_length = 9;
-    
-    for (int signal_index = 0; signal_index < pattern_length; signal_index++) {
-        string signal_type = sos_pattern[signal_index];
-        int flash_duration = (signal_type == "SHORT") ? 300 : 800;
-        
-        generate_illumination_pattern("EMERGENCY_FLASH", 100);
-        cout << "SOS SIGNAL: " << signal_type << " FLASH" << endl;
-        this_thread::sleep_for(milliseconds(flash_duration));
-        
-        generate_illumination_pattern("OFF", 0);
-        cout << "Signal pause..." << endl;
-        this_thread::sleep_for(milliseconds(200));
+    // SOS pattern: 3 short, 3 long, 3 short flashes, played from the compile-time segment table
+    steady_clock::time_point segment_deadline = steady_clock::now();
+    for (const pattern_segment& segment : emergency_cycle_segments) {
+        generate_illumination_pattern(segment.pattern, segment.intensity_level);
+        console_output << segment.narration << end_line;
+        segment_deadline += microseconds(segment.duration_microseconds);
+        if (!wait_in_light_event_loop(segment_deadline)) {
+            break;
+        }
+    }
+    if (sequence_event_loop.stop_requested) {
+        generate_illumination_pattern(PATTERN_OFF, 0);
     }
     
-    cout << "Emergency SOS signal pattern completed." << endl;
+    console_output << "Emergency SOS signal pattern completed." << end_line;
 }
 
 // This function demonstrates variable brightness levels and intensity control
 void execute_brightness_level_demonstration() {
     display_operational_status("BRIGHTNESS LEVEL CONTROL", 0);
     
-    // Demonstrate brightness levels from minimum to maximum
-    int brightness_levels[] = {25, 50, 75, 100};
-    string level_descriptions[] = {"LOW", "MEDIUM", "HIGH", "MAXIMUM"};
+    // Demonstrate brightness levels from minimum to maximum, as declared in the compile-time step table
+    frame_pacing_statistics pacing_statistics;
+    int previous_brightness = 0;
     
-    for (int level_index = 0; level_index < 4; level_index++) {
-        int current_brightness = brightness_levels[level_index];
-        string level_description = level_descriptions[level_index];
+    for (const brightness_demonstration_step& step : brightness_demonstration_steps) {
+        if (sequence_event_loop.stop_requested) {
+            break;
+        }
+        int current_brightness = step.intensity_level;
+        display_operational_status(step.mode_title, current_brightness);
         
-        display_operational_status("BRIGHTNESS: " + level_description, current_brightness);
-        generate_illumination_pattern("VARIABLE_BRIGHTNESS", current_brightness);
+        // Fade smoothly into the new level, then hold it for the rest of the 1.5 second step; the step
+        // deadline derives from its start, so the fade and the status text never lengthen the step
+        steady_clock::time_point step_start = steady_clock::now();
+        execute_brightness_ramp(previous_brightness, current_brightness,
+                                duration_cast<milliseconds>(microseconds(brightness_fade_microseconds)),
+                                RAMP_EASE_IN_OUT, pacing_statistics);
         
-        cout << "Brightness Level: " << level_description 
-             << " (" << current_brightness << "%)" << endl;
-        this_thread::sleep_for(milliseconds(1500));
+        console_output << "\nBrightness Level: " << step.description
+                       << " (" << current_brightness << "%)" << end_line;
+        previous_brightness = current_brightness;
+        if (!wait_in_light_event_loop(step_start + microseconds(brightness_fade_microseconds + brightness_hold_microseconds))) {
+            break;
+        }
+    }
+    
+    // Without truecolor, levels between the shade glyphs are approximated by temporal dithering
+    if (active_render_mode == RENDER_PWM_SHADE && !sequence_event_loop.stop_requested) {
+        int intermediate_levels[] = {90, 62, 37, 10};
+        pwm_duty_statistics duty_statistics[4];
+        int holds_played = 0;
+        while (holds_played < 4 && !sequence_event_loop.stop_requested) {
+            console_output << "Dithered Level: " << intermediate_levels[holds_played] << "% at "
+                           << launch_options.pwm_frequency_hertz << " Hz" << end_line;
+            duty_statistics[holds_played] = execute_pwm_dithered_hold(intermediate_levels[holds_played], milliseconds(1000));
+            console_output << end_line;
+            previous_brightness = intermediate_levels[holds_played];
+            holds_played++;
+        }
+        display_pwm_duty_statistics(duty_statistics, holds_played);
     }
     
-    // Return to off state
-    generate_illumination_pattern("OFF", 0);
-    cout << "Brightness demonstration completed." << endl;
+    // Fade out along the exponential curve before returning to the off state
+    execute_brightness_ramp(previous_brightness, 0, milliseconds(500), RAMP_EXPONENTIAL, pacing_statistics);
+    generate_illumination_pattern(PATTERN_OFF, 0);
+    display_frame_pacing_statistics(pacing_statistics, launch_options.ramp_frames_per_second);
+    console_output << "Brightness demonstration completed." << end_line;
 }
 
 // This function generates illumination patterns based on specified parameters
-void generate_illumination_pattern(string pattern_type, int intensity_level) {
-    if (pattern_type == "OFF") {
+void generate_illumination_pattern(illumination_pattern_id pattern, int intensity_level) {
+    // Render the frame once so the console and every broadcast sink receive identical bytes;
+    // the workspace buffer keeps its capacity, so composing a frame does not allocate
+    string& illumination_frame = render_workspace.illumination_frame;
+    illumination_frame.clear();
+    
+    if (pattern == PATTERN_OFF) {
         // Clear screen and return to normal display
-        cout << string(80, ' ') << "\r" << flush;
-        return;
+        illumination_frame.append(80, ' ');
+        illumination_frame += "\r";
+    } else if (active_render_mode == RENDER_TRUECOLOR) {
+        // Intensity is carried by background luminance across the full bar
+        illumination_frame += "\r[LIGHT] ";
+        append_truecolor_illumination_bar(illumination_frame, intensity_level);
+        append_intensity_label(illumination_frame, intensity_level);
+    } else if (active_render_mode == RENDER_PALETTE_256) {
+        // Same full-width luminance bar, quantized to the nearest xterm palette entry
+        illumination_frame += "\r[LIGHT] ";
+        append_palette_illumination_bar(illumination_frame, intensity_level);
+        append_intensity_label(illumination_frame, intensity_level);
+    } else if (active_render_mode == RENDER_ORDERED_DITHER) {
+        // The whole screen area is dithered, so intensity is no longer limited to five glyph steps
+        append_ordered_dither_screen(illumination_frame, intensity_level);
+    } else if (active_render_mode == RENDER_HALF_BLOCK_BEAM || active_render_mode == RENDER_BRAILLE_BEAM) {
+        // A flashlight cone whose brightness follows the requested intensity
+        append_beam_screen(illumination_frame, intensity_level);
+    } else if (active_render_mode == RENDER_PWM_SHADE) {
+        // A single frame shows the nearest shade level; holds toggle between levels over time
+        append_pwm_shade_bar(illumination_frame, (min(100, max(0, intensity_level)) + 12) / 25, intensity_level);
+    } else {
+        // Shade glyph bar whose width follows the intensity
+        append_shade_illumination_bar(illumination_frame, pattern, intensity_level);
     }
     
-    // Calculate number of illumination characters based on intensity
-    int illumination_width = (intensity_level * 60) / 100;
+    emit_illumination_frame(illumination_frame, pattern, intensity_level);
+}
+
+// This function writes a rendered frame to the console and every configured frame consumer
+void emit_illumination_frame(const string& illumination_frame, illumination_pattern_id pattern, int intensity_level) {
+    console_output << illumination_frame << flush_output;
     
-    // Generate appropriate illumination character pattern
-    char illumination_character;
-    if (pattern_type == "STEADY_BRIGHT" || pattern_type == "VARIABLE_BRIGHTNESS") {
-        illumination_character = '█'; // Solid block for steady illumination
-    } else if (pattern_type == "STROBE_FLASH") {
-        illumination_character = '▓'; // Medium shade for strobe effect
-    } else if (pattern_type == "EMERGENCY_FLASH") {
-        illumination_character = '▒'; // Light shade for emergency signals
-    } else {
-        illumination_character = '░'; // Lightest shade for default
+    // Mirror the rendered frame to additional terminals without waiting on any of them
+    if (broadcast_hub.active) {
+        publish_frame_to_broadcast_sinks(illumination_frame);
     }
     
-    // Output illumination pattern to console
-    cout << "\r[LIGHT] ";
-    for (int character_index = 0; character_index < illumination_width; character_index++) {
-        cout << illumination_character;
+    // Expose the structured light state to local monitoring processes
+    if (published_frame_ring != nullptr) {
+        publish_light_frame(published_frame_ring,
+                            duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count(),
+                            static_cast<uint32_t>(intensity_level), pattern);
     }
-    cout << " [" << intensity_level << "%]" << flush;
 }
 
 // This function displays current operational status and power level
-void display_operational_status(string mode_description, int power_level) {
-    cout << "\n" << string(70, '-') << endl;
-    cout << "OPERATIONAL MODE: " << mode_description << endl;
-    cout << "Power Level: " << power_level << "%" << endl;
-    cout << "Status: ACTIVE" << endl;
-    cout << string(70, '-') << endl;
+void display_operational_status(const char* mode_description, int power_level) {
+    status_text_buffer status_block;
+    status_block.append_text("\n");
+    status_block.append_text(status_separator_line.c_str());
+    status_block.append_text("\nOPERATIONAL MODE: ");
+    status_block.append_text(mode_description);
+    status_block.append_text("\nPower Level: ");
+    status_block.append_number(power_level);
+    status_block.append_text("%\nStatus: ACTIVE\n");
+    status_block.append_text(status_separator_line.c_str());
+    status_block.append_text("\n");
+    write_status_text(status_block);
 }
 
 // This function clears the console screen for clean display output
 void clear_console_screen() {
+    // Pending text must reach the terminal before the clear command runs
+    console_output.flush_buffer();
+    
     // Cross-platform screen clearing implementation
     #ifdef _WIN32
         system("cls");
@@ -231,12 +1435,4534 @@ void clear_console_screen() {
 
 // This function displays program completion status and termination message
 void display_program_termination() {
-    cout << "\n\n" << string(80, '=') << endl;
-    cout << "               FLASHLIGHT APPLICATION OPERATION COMPLETED" << endl;
-    cout << "                        All Systems Deactivated" << endl;
-    cout << string(80, '=') << endl;
-    cout << "Flashlight functionality demonstration completed successfully." << endl;
-    cout << "Console illumination system has been properly shut down." << endl;
-    cout << "Program terminated with successful operational status." << endl;
-    cout << string(80, '=') << endl;
+    console_output << "\n\n" << string(80, '=') << end_line;
+    console_output << "               FLASHLIGHT APPLICATION OPERATION COMPLETED" << end_line;
+    console_output << "                        All Systems Deactivated" << end_line;
+    console_output << string(80, '=') << end_line;
+    console_output << "Flashlight functionality demonstration completed successfully." << end_line;
+    console_output << "Console illumination system has been properly shut down." << end_line;
+    console_output << "Program terminated with successful operational status." << end_line;
+    console_output << string(80, '=') << end_line;
+}
+
+// This function parses command line options into the global launch configuration
+bool parse_command_line_options(int argc, char* argv[]) {
+    for (int argument_index = 1; argument_index < argc; argument_index++) {
+        string argument = argv[argument_index];
+        
+        if (argument == "--broadcast" && argument_index + 1 < argc) {
+            launch_options.broadcast_device_paths.push_back(argv[++argument_index]);
+        } else if (argument == "--sync" && argument_index + 1 < argc) {
+            launch_options.synchronized_pattern_name = argv[++argument_index];
+            if (find_synchronized_cycle(launch_options.synchronized_pattern_name) == nullptr) {
+                console_error << "Unknown synchronized pattern: " << launch_options.synchronized_pattern_name << end_line;
+                return false;
+            }
+        } else if (argument == "--sync-name" && argument_index + 1 < argc) {
+            launch_options.synchronized_segment_name = argv[++argument_index];
+        } else if (argument == "--sync-cycles" && argument_index + 1 < argc) {
+            launch_options.synchronized_cycle_count = max(1, atoi(argv[++argument_index]));
+        } else if (argument == "--sync-phase-test" && argument_index + 1 < argc) {
+            launch_options.phase_test_instance_count = max(2, atoi(argv[++argument_index]));
+        } else if (argument == "--publish-frames") {
+            launch_options.publish_frame_ring = true;
+        } else if (argument == "--monitor-frames") {
+            launch_options.monitor_frame_ring = true;
+        } else if (argument == "--frame-ring" && argument_index + 1 < argc) {
+            launch_options.frame_ring_name = argv[++argument_index];
+        } else if (argument == "--frame-ring-benchmark" && argument_index + 1 < argc) {
+            launch_options.frame_ring_benchmark_seconds = max(1, atoi(argv[++argument_index]));
+        } else if (argument == "--ramp-fps" && argument_index + 1 < argc) {
+            launch_options.ramp_frames_per_second = min(1000, max(1, atoi(argv[++argument_index])));
+        } else if (argument == "--pwm-hz" && argument_index + 1 < argc) {
+            launch_options.pwm_frequency_hertz = min(500, max(1, atoi(argv[++argument_index])));
+        } else if (argument == "--dither-benchmark") {
+            launch_options.dither_benchmark = true;
+        } else if (argument == "--allocation-check") {
+            launch_options.allocation_check = true;
+        } else if (argument == "--program-benchmark" && argument_index + 1 < argc) {
+            launch_options.program_benchmark_edges = max(1000, atoi(argv[++argument_index]));
+        } else if (argument == "--status-format-benchmark" && argument_index + 1 < argc) {
+            launch_options.status_format_benchmark_seconds = max(1, atoi(argv[++argument_index]));
+        } else if (argument == "--light-program" && argument_index + 1 < argc) {
+            launch_options.light_program_name = argv[++argument_index];
+            if (!select_light_program(launch_options.light_program_name)) {
+                return false;
+            }
+        } else if (argument == "--vm-benchmark") {
+            launch_options.light_vm_benchmark = true;
+        } else if (argument == "--compaction-report") {
+            launch_options.compaction_report = true;
+        } else if (argument == "--start-at" && argument_index + 1 < argc) {
+            // The offset is range-checked as a double: converting an infinite or huge value is undefined
+            char* parse_end = nullptr;
+            double start_seconds = strtod(argv[++argument_index], &parse_end);
+            if (parse_end == argv[argument_index] || *parse_end != '\0' || !isfinite(start_seconds) ||
+                start_seconds < 0.0 || start_seconds > START_OFFSET_MAXIMUM_SECONDS) {
+                console_error << "Start offset must be a number of seconds between 0 and "
+                              << START_OFFSET_MAXIMUM_SECONDS << ": " << argv[argument_index] << end_line;
+                return false;
+            }
+            launch_options.start_offset_microseconds = llround(start_seconds * 1000000.0);
+        } else if (argument == "--seek-benchmark" && argument_index + 1 < argc) {
+            launch_options.seek_benchmark_edges = max(1000, atoi(argv[++argument_index]));
+        } else if (argument == "--pause-test" && argument_index + 1 < argc) {
+            launch_options.pause_test_count = min(100, max(1, atoi(argv[++argument_index])));
+        } else if (argument == "--speed" && argument_index + 1 < argc) {
+            launch_options.playback_speed_factor = atof(argv[++argument_index]);
+            if (!(launch_options.playback_speed_factor >= 0.1 && launch_options.playback_speed_factor <= 100.0)) {
+                console_error << "Speed factor must lie between 0.1 and 100: " << argv[argument_index] << end_line;
+                return false;
+            }
+        } else if (argument == "--spin-below" && argument_index + 1 < argc) {
+            launch_options.spin_wait_microseconds = min(100000, max(0, atoi(argv[++argument_index])));
+        } else if (argument == "--speed-benchmark") {
+            launch_options.speed_benchmark = true;
+        } else if (argument == "--spin-margin" && argument_index + 1 < argc) {
+            launch_options.spin_margin_microseconds = min(100000, max(0, atoi(argv[++argument_index])));
+        } else if (argument == "--waiter-benchmark") {
+            launch_options.waiter_benchmark = true;
+        } else if (argument == "--control-socket" && argument_index + 1 < argc) {
+            launch_options.control_socket_path = argv[++argument_index];
+        } else if (argument == "--event-loop-benchmark" && argument_index + 1 < argc) {
+            launch_options.event_loop_benchmark_seconds = min(86400, max(1, atoi(argv[++argument_index])));
+        } else if (argument == "--beacon" && argument_index + 1 < argc) {
+            launch_options.beacon_pattern_name = argv[++argument_index];
+            if (launch_options.beacon_pattern_name != "steady" &&
+                find_synchronized_cycle(launch_options.beacon_pattern_name) == nullptr) {
+                console_error << "Unknown beacon pattern: " << launch_options.beacon_pattern_name << end_line;
+                return false;
+            }
+        } else if (argument == "--beacon-hours" && argument_index + 1 < argc) {
+            launch_options.beacon_hours = min(BEACON_MAXIMUM_HOURS, max(0.0, atof(argv[++argument_index])));
+        } else if (argument == "--beacon-report-minutes" && argument_index + 1 < argc) {
+            launch_options.beacon_report_minutes = min(10080, max(1, atoi(argv[++argument_index])));
+        } else if (argument == "--beacon-benchmark" && argument_index + 1 < argc) {
+            launch_options.beacon_benchmark_seconds = min(86400, max(1, atoi(argv[++argument_index])));
+        } else if (argument == "--realtime") {
+            launch_options.realtime_timing = true;
+        } else if (argument == "--realtime-priority" && argument_index + 1 < argc) {
+            launch_options.realtime_priority = min(99, max(1, atoi(argv[++argument_index])));
+        } else if (argument == "--timing-cpu" && argument_index + 1 < argc) {
+            launch_options.timing_cpu = max(0, atoi(argv[++argument_index]));
+        } else if (argument == "--realtime-stress-test" && argument_index + 1 < argc) {
+            launch_options.realtime_stress_seconds = min(600, max(1, atoi(argv[++argument_index])));
+        } else if (argument == "--row-fill-benchmark") {
+            launch_options.row_fill_benchmark = true;
+        } else if (argument == "--beam-benchmark") {
+            launch_options.beam_benchmark = true;
+        } else if (argument == "--ascii") {
+            launch_options.force_ascii_glyphs = true;
+        } else if (argument == "--render" && argument_index + 1 < argc) {
+            launch_options.render_mode_name = argv[++argument_index];
+        } else {
+            console_error << "Unrecognized or incomplete option: " << argument << end_line;
+            return false;
+        }
+    }
+    return true;
+}
+
+// This function displays the supported command line options
+void display_command_line_usage(const char* program_name) {
+    console_error << "Usage: " << program_name << " [options]" << end_line;
+    console_error << "  --broadcast PATH   Mirror every light frame to PATH (tty, pty or pipe); repeatable" << end_line;
+    console_error << "  --sync PATTERN     Play strobe or sos aligned with other instances on this host" << end_line;
+    console_error << "  --sync-name NAME   Shared-memory clock segment name (default /artlest_flashlight_sync)" << end_line;
+    console_error << "  --sync-cycles N    Number of synchronized pattern cycles to play (default 5)" << end_line;
+    console_error << "  --sync-phase-test N  Spawn N synchronized instances and report their phase error" << end_line;
+    console_error << "  --publish-frames   Publish every light frame into the shared-memory frame ring" << end_line;
+    console_error << "  --monitor-frames   Follow the frame ring of a running instance (reference reader)" << end_line;
+    console_error << "  --frame-ring NAME  Frame ring segment name (default /artlest_flashlight_frames)" << end_line;
+    console_error << "  --frame-ring-benchmark SECONDS  Measure ring throughput at 1 kHz updates" << end_line;
+    console_error << "  --render MODE      Light renderer: auto (default), shade, truecolor, pwm, dither," << end_line;
+    console_error << "                     halfblock, braille or 256" << end_line;
+    console_error << "  --ascii            Draw with ASCII glyphs even when the locale is UTF-8" << end_line;
+    console_error << "  --ramp-fps N       Frame rate of brightness ramps (default 120)" << end_line;
+    console_error << "  --pwm-hz N         Toggle frequency of the pwm renderer (default 50)" << end_line;
+    console_error << "  --dither-benchmark Measure ordered-dither rendering of a 400x120 cell screen" << end_line;
+    console_error << "  --beam-benchmark   Measure half-block and braille beam rendering of a 400x120 cell screen" << end_line;
+    console_error << "  --row-fill-benchmark  Compare glyph row fill methods for widths from 60 to 4000 cells" << end_line;
+    console_error << "  --allocation-check Fail if the four-phase sequence, with status commands arriving, allocates" << end_line;
+    console_error << "                     from the heap after startup (add --render pwm to cover the dithered holds)" << end_line;
+    console_error << "  --program-benchmark EDGES  Compare arena and heap compilation of an EDGES-edge program" << end_line;
+    console_error << "  --status-format-benchmark SECONDS  Time to_chars status text at 1 kHz (iostream too with the stream baselines)" << end_line;
+    console_error << "  --light-program NAME  Run a bytecode light program: sos-until-stopped," << end_line;
+    console_error << "                     escalating-strobe, or the path of an assembly file" << end_line;
+    console_error << "  --vm-benchmark     Measure light program dispatch rate and edge emission latency" << end_line;
+    console_error << "  --compaction-report  Compact the four-phase sequence timeline and report the edges saved" << end_line;
+    console_error << "  --start-at SECONDS Play the compiled four-phase sequence starting SECONDS into it" << end_line;
+    console_error << "  --seek-benchmark EDGES  Compare timeline seek methods on an EDGES-edge program" << end_line;
+    console_error << "  --pause-test N     Pause a strobe N times mid-flash and check the total lit time" << end_line;
+    console_error << "  --speed FACTOR     Play the compiled sequence or a light program FACTOR times faster" << end_line;
+    console_error << "                     (0.1 to 100)" << end_line;
+    console_error << "  --spin-below US    Spin instead of sleeping for waits shorter than US (default 2000)" << end_line;
+    console_error << "  --speed-benchmark  Measure edge lateness of the compiled sequence at 10x, 30x and 100x" << end_line;
+    console_error << "  --spin-margin US   Wake US before each deadline and spin out the rest (default 150, 0 = sleep only)" << end_line;
+    console_error << "  --waiter-benchmark Compare lateness percentiles and CPU cost of sleep, hybrid and spin waits" << end_line;
+    console_error << "  --realtime         Run timing under SCHED_FIFO, pinned to one CPU, with memory locked and 1 ns timer slack" << end_line;
+    console_error << "  --realtime-priority N  SCHED_FIFO priority for --realtime, 1 to 99 (default 50)" << end_line;
+    console_error << "  --timing-cpu CPU   CPU that --realtime pins the timing thread to (default: the last CPU)" << end_line;
+    console_error << "  --realtime-stress-test SECONDS  Compare 1 ms tick jitter under CPU load with and without --realtime" << end_line;
+    console_error << "  --control-socket PATH  Accept stop and status commands as datagrams on a Unix socket" << end_line;
+    console_error << "                     (built-in sequence and --beacon only; --sync, --light-program, --start-at" << end_line;
+    console_error << "                     and --speed playback do not run on the event loop and take no commands)" << end_line;
+    console_error << "  --event-loop-benchmark SECONDS  Count wakeups and CPU time of a long continuous illumination" << end_line;
+    console_error << "  --beacon PATTERN   Run a low-wakeup beacon: steady, strobe or sos" << end_line;
+    console_error << "  --beacon-hours H   Stop the beacon after H hours, at most 8760 (default: run until stopped)" << end_line;
+    console_error << "  --beacon-report-minutes M  Minutes between beacon status reports (default 60)" << end_line;
+    console_error << "  --beacon-benchmark SECONDS  Compare wakeups/hour and CPU time of each beacon pattern" << end_line;
+}
+
+#ifdef __linux__
+
+// This function opens every broadcast sink and starts the epoll writer thread
+bool initialize_frame_broadcast(const vector<string>& device_paths) {
+    // A reader closing its end of a pipe must not terminate the flashlight
+    signal(SIGPIPE, SIG_IGN);
+    
+    broadcast_hub.epoll_descriptor = epoll_create1(EPOLL_CLOEXEC);
+    broadcast_hub.wakeup_descriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (broadcast_hub.epoll_descriptor < 0 || broadcast_hub.wakeup_descriptor < 0) {
+        console_error << "Broadcast initialization failed: " << strerror(errno) << end_line;
+        return false;
+    }
+    
+    // The wakeup descriptor is identified by an out-of-range sink index
+    epoll_event wakeup_event{};
+    wakeup_event.events = EPOLLIN;
+    wakeup_event.data.u64 = UINT64_MAX;
+    if (epoll_ctl(broadcast_hub.epoll_descriptor, EPOLL_CTL_ADD, broadcast_hub.wakeup_descriptor, &wakeup_event) != 0) {
+        console_error << "Broadcast initialization failed: " << strerror(errno) << end_line;
+        return false;
+    }
+    
+    broadcast_hub.sinks.resize(device_paths.size());
+    for (size_t sink_index = 0; sink_index < device_paths.size(); sink_index++) {
+        broadcast_sink& sink = broadcast_hub.sinks[sink_index];
+        sink.device_path = device_paths[sink_index];
+        sink.file_descriptor = open(sink.device_path.c_str(), O_WRONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+        if (sink.file_descriptor < 0) {
+            console_error << "Cannot open broadcast sink " << sink.device_path << ": " << strerror(errno) << end_line;
+            return false;
+        }
+        
+        // Register with no interest yet; EPOLLOUT is armed only while a write is blocked
+        epoll_event sink_event{};
+        sink_event.events = 0;
+        sink_event.data.u64 = sink_index;
+        if (epoll_ctl(broadcast_hub.epoll_descriptor, EPOLL_CTL_ADD, sink.file_descriptor, &sink_event) != 0) {
+            // Regular files, for example, cannot be watched, and an unwatched sink would never be written
+            console_error << "Cannot watch broadcast sink " << sink.device_path << ": " << strerror(errno) << end_line;
+            return false;
+        }
+    }
+    
+    broadcast_hub.active = true;
+    broadcast_hub.writer_thread = thread(run_broadcast_event_loop);
+    return true;
+}
+
+// This function hands a rendered frame to every sink and wakes the writer thread
+void publish_frame_to_broadcast_sinks(const string& frame_bytes) {
+    steady_clock::time_point rendered_at = steady_clock::now();
+    {
+        lock_guard<mutex> sink_lock(broadcast_hub.sink_mutex);
+        for (broadcast_sink& sink : broadcast_hub.sinks) {
+            if (sink.sink_failed) {
+                continue;
+            }
+            
+            // A slow sink only ever keeps the newest frame queued behind the in-flight one
+            if (sink.queued_frame_present) {
+                sink.frames_superseded++;
+            }
+            sink.queued_frame.assign(frame_bytes);
+            sink.queued_rendered_at = rendered_at;
+            sink.queued_frame_present = true;
+        }
+    }
+    
+    uint64_t wakeup_increment = 1;
+    ssize_t wakeup_result = write(broadcast_hub.wakeup_descriptor, &wakeup_increment, sizeof(wakeup_increment));
+    (void)wakeup_result;
+}
+
+// This function writes as much pending data to one sink as it accepts without blocking
+static void flush_broadcast_sink(broadcast_sink& sink, size_t sink_index) {
+    while (!sink.sink_failed) {
+        // Promote the queued frame once the previous frame has been written completely
+        if (sink.in_flight_frame.empty()) {
+            if (!sink.queued_frame_present) {
+                break;
+            }
+            sink.in_flight_frame.swap(sink.queued_frame);
+            sink.in_flight_rendered_at = sink.queued_rendered_at;
+            sink.in_flight_offset = 0;
+            sink.queued_frame_present = false;
+        }
+        
+        ssize_t bytes_written = write(sink.file_descriptor,
+                                      sink.in_flight_frame.data() + sink.in_flight_offset,
+                                      sink.in_flight_frame.size() - sink.in_flight_offset);
+        if (bytes_written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                sink.sink_failed = true;
+            }
+            break;
+        }
+        
+        sink.in_flight_offset += static_cast<size_t>(bytes_written);
+        if (sink.in_flight_offset == sink.in_flight_frame.size()) {
+            // Record how long this frame waited between rendering and full delivery
+            long long lag_microseconds = duration_cast<microseconds>(
+                steady_clock::now() - sink.in_flight_rendered_at).count();
+            sink.frames_delivered++;
+            sink.total_lag_microseconds += lag_microseconds;
+            sink.maximum_lag_microseconds = max(sink.maximum_lag_microseconds, lag_microseconds);
+            sink.in_flight_frame.clear();
+        }
+    }
+    
+    // Arm EPOLLOUT only while bytes remain, so idle sinks never wake the loop
+    bool needs_write_interest = !sink.sink_failed && !sink.in_flight_frame.empty();
+    if (!sink.sink_failed && needs_write_interest != sink.write_interest_registered) {
+        epoll_event sink_event{};
+        sink_event.events = needs_write_interest ? static_cast<uint32_t>(EPOLLOUT) : 0u;
+        sink_event.data.u64 = sink_index;
+        if (epoll_ctl(broadcast_hub.epoll_descriptor, EPOLL_CTL_MOD, sink.file_descriptor, &sink_event) == 0) {
+            sink.write_interest_registered = needs_write_interest;
+        } else {
+            // Without write interest the sink would never be resumed; drop it rather than stall it silently
+            sink.sink_failed = true;
+        }
+    }
+    if (sink.sink_failed) {
+        epoll_ctl(broadcast_hub.epoll_descriptor, EPOLL_CTL_DEL, sink.file_descriptor, nullptr);
+    }
+}
+
+// This function runs the epoll loop that services every sink independently
+void run_broadcast_event_loop() {
+    epoll_event ready_events[32];
+    
+    // Termination and resize signals belong to the sequence event loop's signalfd on the main thread
+    sigset_t sequence_signals;
+    sigemptyset(&sequence_signals);
+    sigaddset(&sequence_signals, SIGINT);
+    sigaddset(&sequence_signals, SIGTERM);
+    sigaddset(&sequence_signals, SIGWINCH);
+    pthread_sigmask(SIG_BLOCK, &sequence_signals, nullptr);
+    
+    while (true) {
+        int ready_count = epoll_wait(broadcast_hub.epoll_descriptor, ready_events, 32, -1);
+        if (ready_count < 0 && errno != EINTR) {
+            break;
+        }
+        
+        lock_guard<mutex> sink_lock(broadcast_hub.sink_mutex);
+        for (int event_index = 0; event_index < ready_count; event_index++) {
+            uint64_t event_source = ready_events[event_index].data.u64;
+            
+            if (event_source == UINT64_MAX) {
+                // New frames were published: try every sink that has something to send
+                uint64_t wakeup_counter;
+                ssize_t read_result = read(broadcast_hub.wakeup_descriptor, &wakeup_counter, sizeof(wakeup_counter));
+                (void)read_result;
+                for (size_t sink_index = 0; sink_index < broadcast_hub.sinks.size(); sink_index++) {
+                    flush_broadcast_sink(broadcast_hub.sinks[sink_index], sink_index);
+                }
+            } else {
+                // A previously blocked sink can accept more bytes, or has failed
+                broadcast_sink& sink = broadcast_hub.sinks[event_source];
+                if (ready_events[event_index].events & (EPOLLERR | EPOLLHUP)) {
+                    sink.sink_failed = true;
+                }
+                flush_broadcast_sink(sink, event_source);
+            }
+        }
+        
+        if (broadcast_hub.shutdown_requested.load()) {
+            break;
+        }
+    }
+}
+
+// This function stops the writer thread and releases every broadcast descriptor
+void shutdown_frame_broadcast() {
+    broadcast_hub.shutdown_requested.store(true);
+    uint64_t wakeup_increment = 1;
+    ssize_t wakeup_result = write(broadcast_hub.wakeup_descriptor, &wakeup_increment, sizeof(wakeup_increment));
+    (void)wakeup_result;
+    broadcast_hub.writer_thread.join();
+    
+    for (broadcast_sink& sink : broadcast_hub.sinks) {
+        if (sink.file_descriptor >= 0) {
+            close(sink.file_descriptor);
+        }
+    }
+    close(broadcast_hub.wakeup_descriptor);
+    close(broadcast_hub.epoll_descriptor);
+    broadcast_hub.active = false;
+}
+
+#else
+
+// This function reports that frame broadcasting requires the Linux epoll interface
+bool initialize_frame_broadcast(const vector<string>& device_paths) {
+    (void)device_paths;
+    console_error << "Frame broadcasting is only available on Linux." << end_line;
+    return false;
+}
+
+void publish_frame_to_broadcast_sinks(const string& frame_bytes) { (void)frame_bytes; }
+void run_broadcast_event_loop() {}
+void shutdown_frame_broadcast() {}
+
+#endif
+
+// This function displays per-sink delivery and lag statistics for the broadcast session
+void display_broadcast_statistics() {
+    console_output << "\nBROADCAST SINK STATISTICS:" << end_line;
+    for (const broadcast_sink& sink : broadcast_hub.sinks) {
+        long long average_lag = sink.frames_delivered > 0
+            ? sink.total_lag_microseconds / sink.frames_delivered : 0;
+        console_output << "  " << sink.device_path
+                       << " | delivered: " << sink.frames_delivered
+                       << " | superseded: " << sink.frames_superseded
+                       << " | avg lag: " << average_lag << " us"
+                       << " | max lag: " << sink.maximum_lag_microseconds << " us"
+                       << (sink.sink_failed ? " | FAILED" : "") << end_line;
+    }
+}
+
+// Repeating patterns available to synchronized instances
+const synchronized_cycle synchronized_cycles[] = {
+    {"strobe", PATTERN_STROBE_FLASH, strobe_cycle_edges.data(), strobe_cycle_edges.size(),
+     total_segment_duration(strobe_cycle_segments)},
+    {"sos", PATTERN_EMERGENCY_FLASH, emergency_cycle_edges.data(), emergency_cycle_edges.size(),
+     total_segment_duration(emergency_cycle_segments)},
+};
+
+// This function returns the display name of a pattern identifier
+const char* illumination_pattern_name(illumination_pattern_id pattern) {
+    switch (pattern) {
+        case PATTERN_STEADY_BRIGHT:       return "STEADY_BRIGHT";
+        case PATTERN_STROBE_FLASH:        return "STROBE_FLASH";
+        case PATTERN_EMERGENCY_FLASH:     return "EMERGENCY_FLASH";
+        case PATTERN_VARIABLE_BRIGHTNESS: return "VARIABLE_BRIGHTNESS";
+        default:                          return "OFF";
+    }
+}
+
+// This function looks up a synchronized cycle by its command line name
+const synchronized_cycle* find_synchronized_cycle(const string& pattern_name) {
+    for (const synchronized_cycle& cycle : synchronized_cycles) {
+        if (pattern_name == cycle.pattern_name) {
+            return &cycle;
+        }
+    }
+    return nullptr;
+}
+
+// This function looks up a synchronized cycle by the pattern id stored in the shared clock
+const synchronized_cycle* find_synchronized_cycle(illumination_pattern_id pattern) {
+    for (const synchronized_cycle& cycle : synchronized_cycles) {
+        if (pattern == cycle.pattern) {
+            return &cycle;
+        }
+    }
+    return nullptr;
+}
+
+#ifdef __linux__
+
+// This function busy-waits on steady_clock until a deadline, yielding the pipeline between reads
+void spin_until_absolute_deadline(steady_clock::time_point deadline) {
+    while (steady_clock::now() < deadline) {
+#ifdef __SSE2__
+        _mm_pause();
+#endif
+    }
+}
+
+// This function blocks until an absolute steady_clock deadline without accumulating drift. The sleep
+// ends spin_margin_microseconds early, because the kernel's timer slack and wake-up path make it overshoot
+// by tens of microseconds; the remaining margin is spun out on steady_clock
+void wait_until_absolute_deadline(steady_clock::time_point deadline) {
+    // steady_clock is CLOCK_MONOTONIC, so the deadline is meaningful to every process on the host
+    steady_clock::time_point wake_time = deadline - microseconds(launch_options.spin_margin_microseconds);
+    if (steady_clock::now() < wake_time) {
+        long long wake_nanoseconds = duration_cast<nanoseconds>(wake_time.time_since_epoch()).count();
+        timespec wake_spec;
+        wake_spec.tv_sec = static_cast<time_t>(wake_nanoseconds / 1000000000LL);
+        wake_spec.tv_nsec = static_cast<long>(wake_nanoseconds % 1000000000LL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_spec, nullptr) == EINTR) {
+        }
+    }
+    spin_until_absolute_deadline(deadline);
+}
+
+// This function takes the lock that serializes creating, joining, replacing and leaving a shared-memory
+// segment (the synchronized clock or the frame ring). The lock lives in a companion object that is never
+// replaced, so every process locks the same file.
+static int lock_shared_segment(const string& segment_name) {
+    int lock_descriptor = shm_open((segment_name + "_lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (lock_descriptor < 0) {
+        return -1;
+    }
+    while (flock(lock_descriptor, LOCK_EX) != 0) {
+        if (errno != EINTR) {
+            close(lock_descriptor);
+            return -1;
+        }
+    }
+    return lock_descriptor;
+}
+
+// This function clears the slots of instances that exited without leaving and returns how many still play
+static uint32_t prune_synchronized_instances(synchronized_clock_segment* clock_segment) {
+    uint32_t live_instances = 0;
+    for (int32_t& instance_process : clock_segment->attached_processes) {
+        if (instance_process > 0 && kill(instance_process, 0) != 0 && errno == ESRCH) {
+            instance_process = 0;
+        }
+        if (instance_process > 0) {
+            live_instances++;
+        }
+    }
+    clock_segment->attached_instances.store(live_instances);
+    return live_instances;
+}
+
+// This function reports whether an existing clock segment can no longer be trusted: no live instance
+// plays on it any more, or its epoch predates the current CLOCK_MONOTONIC timeline
+static bool synchronized_clock_is_stale(synchronized_clock_segment* clock_segment) {
+    long long now_nanoseconds = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    return clock_segment->epoch_nanoseconds > now_nanoseconds || prune_synchronized_instances(clock_segment) == 0;
+}
+
+// This function maps an existing clock segment that live instances still play on. A stale or
+// never-initialized segment is unlinked so the caller can start a new timeline. Requires the clock lock.
+static synchronized_clock_segment* map_live_synchronized_clock(const string& segment_name) {
+    int segment_descriptor = shm_open(segment_name.c_str(), O_RDWR, 0600);
+    if (segment_descriptor < 0) {
+        return nullptr;
+    }
+    struct stat segment_status;
+    bool segment_sized = fstat(segment_descriptor, &segment_status) == 0 &&
+                         segment_status.st_size >= static_cast<off_t>(sizeof(synchronized_clock_segment));
+    void* segment_memory = segment_sized
+        ? mmap(nullptr, sizeof(synchronized_clock_segment), PROT_READ | PROT_WRITE, MAP_SHARED, segment_descriptor, 0)
+        : MAP_FAILED;
+    close(segment_descriptor);
+    
+    // Segments are created and initialized under the lock, so an unready one belongs to a creator that died
+    bool segment_ready = false;
+    if (segment_memory != MAP_FAILED) {
+        synchronized_clock_segment* clock_segment = static_cast<synchronized_clock_segment*>(segment_memory);
+        segment_ready = clock_segment->segment_state.load(memory_order_acquire) == SYNCHRONIZED_SEGMENT_READY;
+        if (segment_ready && !synchronized_clock_is_stale(clock_segment)) {
+            return clock_segment;
+        }
+        munmap(segment_memory, sizeof(synchronized_clock_segment));
+    }
+    console_output << "Synchronized clock " << segment_name << (segment_ready ? " was left by exited processes"
+                   : " was never initialized") << "; starting a new shared timeline." << end_line;
+    shm_unlink(segment_name.c_str());
+    return nullptr;
+}
+
+// This function creates a clock segment whose timeline starts now. Requires the clock lock.
+static synchronized_clock_segment* create_synchronized_clock(const string& segment_name, const synchronized_cycle& requested_cycle) {
+    int segment_descriptor = shm_open(segment_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (segment_descriptor < 0) {
+        console_error << "Cannot create synchronized clock " << segment_name << ": " << strerror(errno) << end_line;
+        return nullptr;
+    }
+    void* segment_memory = MAP_FAILED;
+    if (ftruncate(segment_descriptor, sizeof(synchronized_clock_segment)) == 0) {
+        segment_memory = mmap(nullptr, sizeof(synchronized_clock_segment), PROT_READ | PROT_WRITE,
+                              MAP_SHARED, segment_descriptor, 0);
+    }
+    close(segment_descriptor);
+    if (segment_memory == MAP_FAILED) {
+        console_error << "Cannot size or map synchronized clock: " << strerror(errno) << end_line;
+        shm_unlink(segment_name.c_str());
+        return nullptr;
+    }
+    
+    // The creator defines the timeline origin and pattern, then publishes them with release ordering
+    synchronized_clock_segment* clock_segment = static_cast<synchronized_clock_segment*>(segment_memory);
+    clock_segment->pattern_id = requested_cycle.pattern;
+    clock_segment->epoch_nanoseconds = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    clock_segment->attached_instances.store(0);
+    clock_segment->segment_state.store(SYNCHRONIZED_SEGMENT_READY, memory_order_release);
+    return clock_segment;
+}
+
+// This function creates or joins the shared clock segment, registers this process on it and returns its
+// mapping. The segment is private to the user; while any instance plays, every newcomer joins its timeline.
+synchronized_clock_segment* attach_synchronized_clock(const string& segment_name, const synchronized_cycle& requested_cycle) {
+    int lock_descriptor = lock_shared_segment(segment_name);
+    if (lock_descriptor < 0) {
+        console_error << "Cannot lock synchronized clock " << segment_name << ": " << strerror(errno) << end_line;
+        return nullptr;
+    }
+    synchronized_clock_segment* clock_segment = map_live_synchronized_clock(segment_name);
+    if (clock_segment == nullptr) {
+        clock_segment = create_synchronized_clock(segment_name, requested_cycle);
+    }
+    
+    if (clock_segment != nullptr) {
+        int32_t* free_slot = find(begin(clock_segment->attached_processes), end(clock_segment->attached_processes), 0);
+        if (free_slot == end(clock_segment->attached_processes)) {
+            console_error << "Synchronized clock " << segment_name << " already has " << SYNCHRONIZED_MAXIMUM_INSTANCES
+                          << " instances" << end_line;
+            munmap(clock_segment, sizeof(synchronized_clock_segment));
+            clock_segment = nullptr;
+        } else {
+            *free_slot = static_cast<int32_t>(getpid());
+            clock_segment->attached_instances.fetch_add(1);
+        }
+    }
+    close(lock_descriptor);
+    return clock_segment;
+}
+
+// This function unregisters this process from the clock segment and unmaps it. The last instance to leave
+// unlinks the segment, so a new timeline only ever starts once nobody plays the old one.
+void detach_synchronized_clock(const string& segment_name, synchronized_clock_segment* clock_segment) {
+    int lock_descriptor = lock_shared_segment(segment_name);
+    int32_t* own_slot = find(begin(clock_segment->attached_processes), end(clock_segment->attached_processes),
+                             static_cast<int32_t>(getpid()));
+    if (own_slot != end(clock_segment->attached_processes)) {
+        *own_slot = 0;
+    }
+    if (prune_synchronized_instances(clock_segment) == 0) {
+        shm_unlink(segment_name.c_str());
+    }
+    munmap(clock_segment, sizeof(synchronized_clock_segment));
+    if (lock_descriptor >= 0) {
+        close(lock_descriptor);
+    }
+}
+
+// This function plays the shared pattern with every edge aligned to the shared absolute timeline
+void execute_synchronized_pattern_mode(vector<long long>* edge_timestamps) {
+    const synchronized_cycle* requested_cycle = find_synchronized_cycle(launch_options.synchronized_pattern_name);
+    synchronized_clock_segment* clock_segment =
+        attach_synchronized_clock(launch_options.synchronized_segment_name, *requested_cycle);
+    if (clock_segment == nullptr) {
+        return;
+    }
+    
+    // Every instance plays the pattern recorded in the segment, even if it asked for another one
+    const synchronized_cycle* shared_cycle =
+        find_synchronized_cycle(static_cast<illumination_pattern_id>(clock_segment->pattern_id));
+    if (shared_cycle == nullptr) {
+        console_error << "Synchronized clock holds an unknown pattern id " << clock_segment->pattern_id << end_line;
+        detach_synchronized_clock(launch_options.synchronized_segment_name, clock_segment);
+        return;
+    }
+    
+    char mode_description[48];
+    snprintf(mode_description, sizeof(mode_description), "SYNCHRONIZED %s PATTERN", shared_cycle->pattern_name);
+    display_operational_status(mode_description, 100);
+    if (shared_cycle != requested_cycle) {
+        console_output << "Shared clock already plays " << shared_cycle->pattern_name << "; following it." << end_line;
+    }
+    console_output << "Attached instances: " << clock_segment->attached_instances.load() << end_line;
+    
+    // Start on the next cycle boundary of the shared timeline, leaving time to prepare the first frame
+    long long cycle_nanoseconds = shared_cycle->cycle_microseconds * 1000;
+    long long epoch_nanoseconds = clock_segment->epoch_nanoseconds;
+    long long earliest_start = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() + 50000000LL;
+    long long elapsed_cycles = (earliest_start - epoch_nanoseconds + cycle_nanoseconds - 1) / cycle_nanoseconds;
+    long long first_cycle_start = epoch_nanoseconds + max(0LL, elapsed_cycles) * cycle_nanoseconds;
+    
+    // Join the cycle already in progress instead of staying dark until the boundary: the time index
+    // finds the state in effect at the join moment. Catch-up edges are not recorded, so every instance
+    // reports the same counted cycles to the phase test.
+    long long current_cycle_start = first_cycle_start - cycle_nanoseconds;
+    if (current_cycle_start >= epoch_nanoseconds && earliest_start < first_cycle_start) {
+        timeline_time_index time_index(pmr::get_default_resource());
+        build_timeline_time_index(shared_cycle->edges, shared_cycle->edge_count, time_index);
+        timeline_seek_position join_position = seek_timeline(shared_cycle->edges, shared_cycle->edge_count, time_index,
+                                                             (earliest_start - current_cycle_start) / 1000);
+        console_output << "Joining the cycle in progress at " << (earliest_start - current_cycle_start) / 1000000
+                       << " ms (edge " << join_position.edge_index + 1 << " of " << shared_cycle->edge_count << ")" << end_line;
+        
+        wait_until_absolute_deadline(steady_clock::time_point(nanoseconds(earliest_start)));
+        const timeline_edge& joined_edge = shared_cycle->edges[join_position.edge_index];
+        generate_illumination_pattern(joined_edge.pattern, joined_edge.intensity_level);
+        for (size_t edge_index = join_position.edge_index + 1; edge_index < shared_cycle->edge_count; edge_index++) {
+            const timeline_edge& edge = shared_cycle->edges[edge_index];
+            wait_until_absolute_deadline(steady_clock::time_point(
+                nanoseconds(current_cycle_start + edge.offset_microseconds * 1000)));
+            generate_illumination_pattern(edge.pattern, edge.intensity_level);
+        }
+    }
+    
+    for (int cycle_index = 0; cycle_index < launch_options.synchronized_cycle_count; cycle_index++) {
+        long long cycle_start = first_cycle_start + cycle_index * cycle_nanoseconds;
+        for (size_t edge_index = 0; edge_index < shared_cycle->edge_count; edge_index++) {
+            const timeline_edge& edge = shared_cycle->edges[edge_index];
+            wait_until_absolute_deadline(steady_clock::time_point(
+                nanoseconds(cycle_start + edge.offset_microseconds * 1000)));
+            generate_illumination_pattern(edge.pattern, edge.intensity_level);
+            
+            if (edge_timestamps != nullptr) {
+                edge_timestamps->push_back(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+            }
+        }
+    }
+    
+    // Hold the final pause until the last cycle ends so the next run starts on a boundary
+    wait_until_absolute_deadline(steady_clock::time_point(
+        nanoseconds(first_cycle_start + launch_options.synchronized_cycle_count * cycle_nanoseconds)));
+    generate_illumination_pattern(PATTERN_OFF, 0);
+    console_output << "\nSynchronized pattern completed after " << launch_options.synchronized_cycle_count << " cycles." << end_line;
+    
+    detach_synchronized_clock(launch_options.synchronized_segment_name, clock_segment);
+}
+
+// This function spawns synchronized instances and reports the spread of their edge times
+int execute_synchronized_phase_test(int instance_count) {
+    // A private segment keeps the test independent from instances already running on the host
+    launch_options.synchronized_segment_name = "/artlest_flashlight_phase_test_" + to_string(getpid());
+    if (launch_options.synchronized_pattern_name.empty()) {
+        launch_options.synchronized_pattern_name = "strobe";
+    }
+    launch_options.synchronized_cycle_count = min(launch_options.synchronized_cycle_count, 5);
+    
+    console_output << "SYNCHRONIZED PHASE ERROR TEST: " << instance_count << " instances, "
+                   << launch_options.synchronized_cycle_count << " " << launch_options.synchronized_pattern_name
+                   << " cycles" << end_line;
+    
+    vector<int> result_pipes;
+    vector<pid_t> instance_processes;
+    for (int instance_index = 0; instance_index < instance_count; instance_index++) {
+        int pipe_descriptors[2];
+        if (pipe(pipe_descriptors) != 0) {
+            console_error << "Cannot create result pipe: " << strerror(errno) << end_line;
+            return 1;
+        }
+        
+        console_output.flush_buffer(); // A child must not inherit and repeat buffered output
+        pid_t instance_process = fork();
+        if (instance_process == 0) {
+            // Each instance joins at a different moment and renders to /dev/null
+            close(pipe_descriptors[0]);
+            int null_descriptor = open("/dev/null", O_WRONLY);
+            dup2(null_descriptor, STDOUT_FILENO);
+            this_thread::sleep_for(milliseconds(37 * instance_index));
+            
+            vector<long long> edge_timestamps;
+            execute_synchronized_pattern_mode(&edge_timestamps);
+            console_output << flush_output;
+            
+            size_t byte_count = edge_timestamps.size() * sizeof(long long);
+            const char* timestamp_bytes = reinterpret_cast<const char*>(edge_timestamps.data());
+            for (size_t written = 0; written < byte_count;) {
+                ssize_t result = write(pipe_descriptors[1], timestamp_bytes + written, byte_count - written);
+                if (result <= 0) {
+                    break;
+                }
+                written += static_cast<size_t>(result);
+            }
+            _exit(0);
+        }
+        
+        close(pipe_descriptors[1]);
+        result_pipes.push_back(pipe_descriptors[0]);
+        instance_processes.push_back(instance_process);
+    }
+    
+    // Collect every instance's edge timestamps
+    vector<vector<long long>> instance_timestamps(instance_count);
+    for (int instance_index = 0; instance_index < instance_count; instance_index++) {
+        long long timestamp;
+        while (read(result_pipes[instance_index], &timestamp, sizeof(timestamp)) == static_cast<ssize_t>(sizeof(timestamp))) {
+            instance_timestamps[instance_index].push_back(timestamp);
+        }
+        close(result_pipes[instance_index]);
+        waitpid(instance_processes[instance_index], nullptr, 0);
+    }
+    shm_unlink(launch_options.synchronized_segment_name.c_str());
+    shm_unlink((launch_options.synchronized_segment_name + "_lock").c_str());
+    
+    // Instances may start on different cycles; compare edges that occur at the same absolute moment
+    size_t edge_count = instance_timestamps[0].size();
+    for (const vector<long long>& timestamps : instance_timestamps) {
+        if (timestamps.size() != edge_count || edge_count == 0) {
+            console_error << "Instances reported differing edge counts; test inconclusive." << end_line;
+            return 1;
+        }
+    }
+    
+    long long maximum_skew = 0;
+    double total_skew = 0;
+    long long compared_edges = 0;
+    long long cycle_tolerance = 100000000LL; // Edges further apart than 100 ms belong to different cycles
+    for (size_t edge_index = 0; edge_index < edge_count; edge_index++) {
+        long long earliest = instance_timestamps[0][edge_index];
+        long long latest = earliest;
+        for (const vector<long long>& timestamps : instance_timestamps) {
+            earliest = min(earliest, timestamps[edge_index]);
+            latest = max(latest, timestamps[edge_index]);
+        }
+        if (latest - earliest > cycle_tolerance) {
+            continue;
+        }
+        maximum_skew = max(maximum_skew, latest - earliest);
+        total_skew += static_cast<double>(latest - earliest);
+        compared_edges++;
+    }
+    if (compared_edges == 0) {
+        console_error << "Instances never shared a cycle; test inconclusive." << end_line;
+        return 1;
+    }
+    
+    bool phase_aligned = maximum_skew < 1000000LL;
+    console_output << fixed_decimals(1);
+    console_output << "Edges compared: " << compared_edges << end_line;
+    console_output << "Mean phase error: " << total_skew / compared_edges / 1000.0 << " us" << end_line;
+    console_output << "Max phase error: " << maximum_skew / 1000.0 << " us" << end_line;
+    console_output << "Result: " << (phase_aligned ? "PASS (sub-millisecond skew)" : "FAIL (skew above 1 ms)") << end_line;
+    return phase_aligned ? 0 : 1;
+}
+
+#else
+
+// This function busy-waits on steady_clock until a deadline, yielding the pipeline between reads
+void spin_until_absolute_deadline(steady_clock::time_point deadline) {
+    while (steady_clock::now() < deadline) {
+#ifdef __SSE2__
+        _mm_pause();
+#endif
+    }
+}
+
+// This function falls back to a relative sleep where absolute monotonic sleeps are unavailable, still
+// waking spin_margin_microseconds early and spinning out the rest
+void wait_until_absolute_deadline(steady_clock::time_point deadline) {
+    steady_clock::time_point wake_time = deadline - microseconds(launch_options.spin_margin_microseconds);
+    if (steady_clock::now() < wake_time) {
+        this_thread::sleep_until(wake_time);
+    }
+    spin_until_absolute_deadline(deadline);
+}
+
+synchronized_clock_segment* attach_synchronized_clock(const string& segment_name, const synchronized_cycle& requested_cycle) {
+    (void)segment_name;
+    (void)requested_cycle;
+    return nullptr;
+}
+
+// This function reports that synchronized playback requires POSIX shared memory
+void execute_synchronized_pattern_mode(vector<long long>* edge_timestamps) {
+    (void)edge_timestamps;
+    console_error << "Synchronized playback is only available on Linux." << end_line;
+}
+
+int execute_synchronized_phase_test(int instance_count) {
+    (void)instance_count;
+    console_error << "The synchronized phase test is only available on Linux." << end_line;
+    return 1;
+}
+
+#endif
+
+// This function writes one frame into the ring; a single publisher never blocks on readers
+void publish_light_frame(light_frame_ring* ring, long long timestamp_nanoseconds,
+                         uint32_t intensity_level, uint32_t pattern_id) {
+    uint64_t frame_number = ring->published_frames.load(memory_order_relaxed);
+    light_frame_ring_slot& slot = ring->slots[frame_number % LIGHT_FRAME_RING_CAPACITY];
+    
+    // An odd sequence tells readers the slot is being rewritten
+    slot.sequence.store(2 * frame_number + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot.timestamp_nanoseconds.store(timestamp_nanoseconds, memory_order_relaxed);
+    slot.intensity_level.store(intensity_level, memory_order_relaxed);
+    slot.pattern_id.store(pattern_id, memory_order_relaxed);
+    slot.sequence.store(2 * frame_number + 2, memory_order_release);
+    
+    ring->published_frames.store(frame_number + 1, memory_order_release);
+}
+
+// This function copies one frame out of the ring, detecting torn and overwritten slots
+light_frame_read_result read_light_frame(const light_frame_ring* ring, uint64_t frame_number,
+                                         light_frame_snapshot& snapshot) {
+    const light_frame_ring_slot& slot = ring->slots[frame_number % LIGHT_FRAME_RING_CAPACITY];
+    uint64_t expected_sequence = 2 * frame_number + 2;
+    
+    uint64_t sequence_before = slot.sequence.load(memory_order_acquire);
+    if (sequence_before > expected_sequence) {
+        return LIGHT_FRAME_OVERWRITTEN;
+    }
+    if (sequence_before != expected_sequence) {
+        return LIGHT_FRAME_NOT_READY;
+    }
+    
+    snapshot.frame_number = frame_number;
+    snapshot.timestamp_nanoseconds = slot.timestamp_nanoseconds.load(memory_order_relaxed);
+    snapshot.intensity_level = slot.intensity_level.load(memory_order_relaxed);
+    snapshot.pattern_id = slot.pattern_id.load(memory_order_relaxed);
+    
+    // The copy is valid only if the writer did not touch the slot while it was read
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t sequence_after = slot.sequence.load(memory_order_relaxed);
+    return sequence_after == sequence_before ? LIGHT_FRAME_READ : LIGHT_FRAME_OVERWRITTEN;
+}
+
+#ifdef __linux__
+
+// This function reports whether the ring at ring_name belongs to a publisher that is still running.
+// A ring that cannot be inspected, for example one owned by another user, is treated as in use.
+static bool light_frame_ring_has_live_publisher(const string& ring_name) {
+    int ring_descriptor = shm_open(ring_name.c_str(), O_RDONLY, 0600);
+    if (ring_descriptor < 0) {
+        return errno != ENOENT;
+    }
+    struct stat ring_status;
+    bool ring_sized = fstat(ring_descriptor, &ring_status) == 0 &&
+                      ring_status.st_size >= static_cast<off_t>(sizeof(light_frame_ring));
+    void* ring_memory = ring_sized
+        ? mmap(nullptr, sizeof(light_frame_ring), PROT_READ, MAP_SHARED, ring_descriptor, 0) : MAP_FAILED;
+    close(ring_descriptor);
+    if (ring_memory == MAP_FAILED) {
+        return false;
+    }
+    const light_frame_ring* ring = static_cast<const light_frame_ring*>(ring_memory);
+    bool publisher_alive = ring->ring_magic.load(memory_order_acquire) == LIGHT_FRAME_RING_MAGIC &&
+                           ring->publisher_process > 0 &&
+                           (kill(ring->publisher_process, 0) == 0 || errno != ESRCH);
+    munmap(ring_memory, sizeof(light_frame_ring));
+    return publisher_alive;
+}
+
+// This function creates the ring under the segment lock. A ring whose publisher has exited without
+// removing it is replaced; one a running publisher still writes is left alone and reported.
+static int create_light_frame_ring_descriptor(const string& ring_name) {
+    int lock_descriptor = lock_shared_segment(ring_name);
+    if (lock_descriptor < 0) {
+        console_error << "Cannot lock frame ring " << ring_name << ": " << strerror(errno) << end_line;
+        return -1;
+    }
+    int ring_descriptor = shm_open(ring_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (ring_descriptor < 0 && errno == EEXIST) {
+        if (light_frame_ring_has_live_publisher(ring_name)) {
+            console_error << "Frame ring " << ring_name << " is in use by another publisher" << end_line;
+            close(lock_descriptor);
+            return -1;
+        }
+        console_output << "Frame ring " << ring_name << " was left by an exited publisher; replacing it." << end_line;
+        shm_unlink(ring_name.c_str());
+        ring_descriptor = shm_open(ring_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    }
+    if (ring_descriptor < 0) {
+        console_error << "Cannot create frame ring " << ring_name << ": " << strerror(errno) << end_line;
+    } else if (ftruncate(ring_descriptor, sizeof(light_frame_ring)) != 0) {
+        console_error << "Cannot size frame ring: " << strerror(errno) << end_line;
+        close(ring_descriptor);
+        shm_unlink(ring_name.c_str());
+        ring_descriptor = -1;
+    }
+    close(lock_descriptor);
+    return ring_descriptor;
+}
+
+// This function creates (publisher) or attaches to (reader) the shared-memory frame ring. The ring is
+// private to the user, and a publisher never takes over a ring another running publisher owns.
+light_frame_ring* open_light_frame_ring(const string& ring_name, bool create_ring) {
+    int ring_descriptor = create_ring ? create_light_frame_ring_descriptor(ring_name)
+                                      : shm_open(ring_name.c_str(), O_RDONLY, 0600);
+    if (ring_descriptor < 0) {
+        if (!create_ring) {
+            console_error << "Cannot open frame ring " << ring_name << ": " << strerror(errno) << end_line;
+        }
+        return nullptr;
+    }
+    
+    void* ring_memory = mmap(nullptr, sizeof(light_frame_ring), create_ring ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                             MAP_SHARED, ring_descriptor, 0);
+    close(ring_descriptor);
+    if (ring_memory == MAP_FAILED) {
+        console_error << "Cannot map frame ring: " << strerror(errno) << end_line;
+        return nullptr;
+    }
+    
+    light_frame_ring* ring = static_cast<light_frame_ring*>(ring_memory);
+    if (create_ring) {
+        // Restart numbering and invalidate every slot before readers see the magic value
+        ring->ring_magic.store(0, memory_order_relaxed);
+        ring->published_frames.store(0, memory_order_relaxed);
+        for (light_frame_ring_slot& slot : ring->slots) {
+            slot.sequence.store(0, memory_order_relaxed);
+        }
+        ring->publisher_active.store(1, memory_order_relaxed);
+        ring->publisher_process = static_cast<int32_t>(getpid());
+        ring->ring_magic.store(LIGHT_FRAME_RING_MAGIC, memory_order_release);
+    } else if (ring->ring_magic.load(memory_order_acquire) != LIGHT_FRAME_RING_MAGIC) {
+        console_error << "Frame ring " << ring_name << " has not been initialized by a publisher." << end_line;
+        munmap(ring_memory, sizeof(light_frame_ring));
+        return nullptr;
+    }
+    return ring;
+}
+
+// This function tells readers the publisher has finished, removes the ring's name and unmaps it.
+// Readers that are still attached keep their mapping until they see publisher_active cleared.
+void close_light_frame_ring(const string& ring_name, light_frame_ring* ring) {
+    ring->publisher_active.store(0, memory_order_release);
+    int lock_descriptor = lock_shared_segment(ring_name);
+    shm_unlink(ring_name.c_str());
+    if (lock_descriptor >= 0) {
+        close(lock_descriptor);
+    }
+    munmap(ring, sizeof(light_frame_ring));
+}
+
+// This function follows a running publisher and prints every frame it observes
+int execute_frame_ring_monitor() {
+    const light_frame_ring* ring = open_light_frame_ring(launch_options.frame_ring_name, false);
+    if (ring == nullptr) {
+        return 1;
+    }
+    
+    console_output << "FRAME RING MONITOR: following " << launch_options.frame_ring_name << end_line;
+    uint64_t next_frame = ring->published_frames.load(memory_order_acquire);
+    long long frames_missed = 0;
+    
+    while (true) {
+        uint64_t published_frames = ring->published_frames.load(memory_order_acquire);
+        
+        // Skip frames the writer has already lapped
+        if (published_frames - next_frame > LIGHT_FRAME_RING_CAPACITY) {
+            frames_missed += static_cast<long long>(published_frames - next_frame - LIGHT_FRAME_RING_CAPACITY);
+            next_frame = published_frames - LIGHT_FRAME_RING_CAPACITY;
+        }
+        
+        while (next_frame < published_frames) {
+            light_frame_snapshot snapshot;
+            light_frame_read_result result = read_light_frame(ring, next_frame, snapshot);
+            if (result == LIGHT_FRAME_NOT_READY) {
+                break;
+            }
+            if (result == LIGHT_FRAME_READ) {
+                console_output << "FRAME " << snapshot.frame_number
+                               << " | t=" << snapshot.timestamp_nanoseconds / 1000 << " us"
+                               << " | pattern: " << illumination_pattern_name(static_cast<illumination_pattern_id>(snapshot.pattern_id))
+                               << " | intensity: " << snapshot.intensity_level << "%" << end_line;
+            } else {
+                frames_missed++;
+            }
+            next_frame++;
+        }
+        
+        if (ring->publisher_active.load(memory_order_acquire) == 0 &&
+            next_frame >= ring->published_frames.load(memory_order_acquire)) {
+            break;
+        }
+        this_thread::sleep_for(milliseconds(1));
+    }
+    
+    console_output << "Publisher finished. Frames missed: " << frames_missed << end_line;
+    return 0;
+}
+
+// This function measures publish cost and reader delivery for a 1 kHz publisher
+int execute_frame_ring_benchmark(int duration_seconds) {
+    string ring_name = "/artlest_flashlight_ring_benchmark_" + to_string(getpid());
+    light_frame_ring* ring = open_light_frame_ring(ring_name, true);
+    if (ring == nullptr) {
+        return 1;
+    }
+    
+    int result_pipe[2];
+    if (pipe(result_pipe) != 0) {
+        console_error << "Cannot create result pipe: " << strerror(errno) << end_line;
+        return 1;
+    }
+    
+    console_output.flush_buffer(); // A child must not inherit and repeat buffered output
+    pid_t reader_process = fork();
+    if (reader_process == 0) {
+        // The reader polls lock-free from a separate process, exactly like an external tool would
+        close(result_pipe[0]);
+        const light_frame_ring* reader_ring = open_light_frame_ring(ring_name, false);
+        long long reader_results[4] = {0, 0, 0, 0}; // received, missed, total latency ns, max latency ns
+        uint64_t next_frame = 0;
+        
+        while (reader_ring != nullptr) {
+            uint64_t published_frames = reader_ring->published_frames.load(memory_order_acquire);
+            if (published_frames - next_frame > LIGHT_FRAME_RING_CAPACITY) {
+                reader_results[1] += static_cast<long long>(published_frames - next_frame - LIGHT_FRAME_RING_CAPACITY);
+                next_frame = published_frames - LIGHT_FRAME_RING_CAPACITY;
+            }
+            while (next_frame < published_frames) {
+                light_frame_snapshot snapshot;
+                light_frame_read_result result = read_light_frame(reader_ring, next_frame, snapshot);
+                if (result == LIGHT_FRAME_NOT_READY) {
+                    break;
+                }
+                if (result == LIGHT_FRAME_READ) {
+                    long long latency = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count()
+                                        - snapshot.timestamp_nanoseconds;
+                    reader_results[0]++;
+                    reader_results[2] += latency;
+                    reader_results[3] = max(reader_results[3], latency);
+                } else {
+                    reader_results[1]++;
+                }
+                next_frame++;
+            }
+            if (reader_ring->publisher_active.load(memory_order_acquire) == 0 &&
+                next_frame >= reader_ring->published_frames.load(memory_order_acquire)) {
+                break;
+            }
+            this_thread::sleep_for(microseconds(100));
+        }
+        
+        ssize_t write_result = write(result_pipe[1], reader_results, sizeof(reader_results));
+        (void)write_result;
+        _exit(0);
+    }
+    close(result_pipe[1]);
+    
+    console_output << "FRAME RING BENCHMARK: 1 kHz updates for " << duration_seconds << " seconds" << end_line;
+    
+    // Publish on absolute 1 ms deadlines and time only the publish call itself
+    long long frame_count = duration_seconds * 1000LL;
+    long long total_publish_nanoseconds = 0;
+    long long maximum_publish_nanoseconds = 0;
+    steady_clock::time_point benchmark_start = steady_clock::now();
+    for (long long frame_index = 0; frame_index < frame_count; frame_index++) {
+        wait_until_absolute_deadline(benchmark_start + milliseconds(frame_index));
+        steady_clock::time_point publish_start = steady_clock::now();
+        publish_light_frame(ring, duration_cast<nanoseconds>(publish_start.time_since_epoch()).count(),
+                            static_cast<uint32_t>(frame_index % 101),
+                            frame_index % 2 == 0 ? PATTERN_STROBE_FLASH : PATTERN_OFF);
+        long long publish_nanoseconds = duration_cast<nanoseconds>(steady_clock::now() - publish_start).count();
+        total_publish_nanoseconds += publish_nanoseconds;
+        maximum_publish_nanoseconds = max(maximum_publish_nanoseconds, publish_nanoseconds);
+    }
+    double elapsed_seconds = duration_cast<duration<double>>(steady_clock::now() - benchmark_start).count();
+    ring->publisher_active.store(0, memory_order_release);
+    
+    long long reader_results[4] = {0, 0, 0, 0};
+    ssize_t read_result = read(result_pipe[0], reader_results, sizeof(reader_results));
+    (void)read_result;
+    close(result_pipe[0]);
+    waitpid(reader_process, nullptr, 0);
+    close_light_frame_ring(ring_name, ring);
+    shm_unlink((ring_name + "_lock").c_str());
+    
+    console_output << fixed_decimals(1);
+    console_output << "Frames published: " << frame_count << " (" << frame_count / elapsed_seconds << " frames/s)" << end_line;
+    console_output << "Publish cost: avg " << static_cast<double>(total_publish_nanoseconds) / frame_count
+                   << " ns, max " << maximum_publish_nanoseconds << " ns" << end_line;
+    console_output << "Frames received by reader: " << reader_results[0] << ", missed: " << reader_results[1] << end_line;
+    if (reader_results[0] > 0) {
+        console_output << "Publish-to-read latency: avg " << reader_results[2] / reader_results[0] / 1000.0
+                       << " us, max " << reader_results[3] / 1000.0 << " us" << end_line;
+    }
+    return reader_results[0] == frame_count ? 0 : 1;
+}
+
+#else
+
+light_frame_ring* open_light_frame_ring(const string& ring_name, bool create_ring) {
+    (void)ring_name;
+    (void)create_ring;
+    console_error << "The shared-memory frame ring is only available on Linux." << end_line;
+    return nullptr;
+}
+
+void close_light_frame_ring(const string& ring_name, light_frame_ring* ring) {
+    (void)ring_name;
+    (void)ring;
+}
+
+int execute_frame_ring_monitor() {
+    return open_light_frame_ring(launch_options.frame_ring_name, false) == nullptr ? 1 : 0;
+}
+
+int execute_frame_ring_benchmark(int duration_seconds) {
+    (void)duration_seconds;
+    return open_light_frame_ring(launch_options.frame_ring_name, true) == nullptr ? 1 : 0;
+}
+
+#endif
+
+// This function raises a value to a positive integer power at compile time
+constexpr double constexpr_integer_power(double base, int exponent) {
+    double result = 1.0;
+    for (int factor = 0; factor < exponent; factor++) {
+        result *= base;
+    }
+    return result;
+}
+
+// This function computes the positive n-th root of a value at compile time by Newton iteration
+constexpr double constexpr_integer_root(double value, int root_degree) {
+    if (value <= 0.0) {
+        return 0.0;
+    }
+    double estimate = 1.0;
+    for (int iteration = 0; iteration < 200; iteration++) {
+        estimate -= (constexpr_integer_power(estimate, root_degree) - value) /
+                    (root_degree * constexpr_integer_power(estimate, root_degree - 1));
+    }
+    return estimate;
+}
+
+// This function builds the table mapping intensity percentage to an sRGB channel value
+constexpr array<uint8_t, 101> build_truecolor_gamma_table() {
+    // Intensity is treated as relative luminance; the sRGB transfer curve turns it into the
+    // code value the terminal must emit so the screen actually produces that luminance
+    array<uint8_t, 101> gamma_table{};
+    for (int intensity_level = 0; intensity_level <= 100; intensity_level++) {
+        double linear_luminance = intensity_level / 100.0;
+        double encoded_value = linear_luminance <= 0.0031308
+            ? 12.92 * linear_luminance
+            : 1.055 * constexpr_integer_root(constexpr_integer_power(linear_luminance, 5), 12) - 0.055;
+        gamma_table[intensity_level] = static_cast<uint8_t>(encoded_value * 255.0 + 0.5);
+    }
+    return gamma_table;
+}
+
+constexpr array<uint8_t, 101> truecolor_gamma_table = build_truecolor_gamma_table();
+static_assert(truecolor_gamma_table[0] == 0, "Zero intensity must map to black");
+static_assert(truecolor_gamma_table[50] == 188, "Half luminance must follow the sRGB curve");
+static_assert(truecolor_gamma_table[100] == 255, "Full intensity must map to white");
+
+// This function detects terminal output features from the standard environment variables
+terminal_capabilities detect_terminal_capabilities() {
+    terminal_capabilities capabilities;
+    const char* color_terminal = getenv("COLORTERM");
+    if (color_terminal != nullptr) {
+        string color_terminal_value = color_terminal;
+        capabilities.supports_truecolor = color_terminal_value == "truecolor" || color_terminal_value == "24bit";
+    }
+    // The first non-empty locale variable decides the character encoding, as in setlocale
+    const char* locale_variables[] = {"LC_ALL", "LC_CTYPE", "LANG"};
+    for (const char* locale_variable : locale_variables) {
+        const char* locale_value = getenv(locale_variable);
+        if (locale_value != nullptr && locale_value[0] != '\0') {
+            string locale_name = locale_value;
+            for (char& locale_character : locale_name) {
+                locale_character = static_cast<char>(tolower(static_cast<unsigned char>(locale_character)));
+            }
+            capabilities.supports_utf8 = locale_name.find("utf-8") != string::npos ||
+                                         locale_name.find("utf8") != string::npos;
+            break;
+        }
+    }
+    
+    const char* terminal_type = getenv("TERM");
+    if (terminal_type != nullptr) {
+        capabilities.supports_256_color = string(terminal_type).find("256color") != string::npos;
+    }
+    
+#ifdef __linux__
+    winsize window_size{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &window_size) == 0 && window_size.ws_col > 0 && window_size.ws_row > 0) {
+        capabilities.screen_columns = window_size.ws_col;
+        capabilities.screen_rows = window_size.ws_row;
+    }
+#endif
+    return capabilities;
+}
+
+// This function resolves the requested renderer against the detected terminal capabilities
+bool select_illumination_render_mode(const string& render_mode_name, const terminal_capabilities& capabilities) {
+    if (render_mode_name == "auto") {
+        active_render_mode = capabilities.supports_truecolor ? RENDER_TRUECOLOR
+                           : capabilities.supports_256_color ? RENDER_PALETTE_256 : RENDER_SHADE_GLYPHS;
+    } else if (render_mode_name == "shade") {
+        active_render_mode = RENDER_SHADE_GLYPHS;
+    } else if (render_mode_name == "truecolor") {
+        active_render_mode = RENDER_TRUECOLOR;
+    } else if (render_mode_name == "pwm") {
+        active_render_mode = RENDER_PWM_SHADE;
+    } else if (render_mode_name == "dither") {
+        active_render_mode = RENDER_ORDERED_DITHER;
+    } else if (render_mode_name == "halfblock") {
+        active_render_mode = RENDER_HALF_BLOCK_BEAM;
+    } else if (render_mode_name == "braille") {
+        active_render_mode = RENDER_BRAILLE_BEAM;
+    } else if (render_mode_name == "256") {
+        active_render_mode = RENDER_PALETTE_256;
+    } else {
+        console_error << "Unknown render mode: " << render_mode_name << end_line;
+        return false;
+    }
+    return true;
+}
+
+// This function formats the background and foreground color escapes for every intensity level once at startup
+void initialize_truecolor_escape_table() {
+    for (int intensity_level = 0; intensity_level <= 100; intensity_level++) {
+        string channel_value = to_string(truecolor_gamma_table[intensity_level]);
+        truecolor_escape_sequences[intensity_level] =
+            "\x1b[48;2;" + channel_value + ";" + channel_value + ";" + channel_value + "m";
+        truecolor_foreground_escape_sequences[intensity_level] =
+            "\x1b[38;2;" + channel_value + ";" + channel_value + ";" + channel_value + "m";
+    }
+}
+
+// This function appends a full-width bar lit at the given intensity using the prebuilt escapes
+void append_truecolor_illumination_bar(string& illumination_frame, int intensity_level) {
+    int clamped_intensity = min(100, max(0, intensity_level));
+    illumination_frame += truecolor_escape_sequences[clamped_intensity];
+    illumination_frame.append(60, ' ');
+    illumination_frame += "\x1b[0m";
+}
+
+// This function evaluates e^x at compile time with a Taylor series
+constexpr double constexpr_exponential(double exponent) {
+    double term = 1.0;
+    double sum = 1.0;
+    for (int series_index = 1; series_index < 80; series_index++) {
+        term *= exponent / series_index;
+        sum += term;
+    }
+    return sum;
+}
+
+// Number of segments in each precomputed easing curve; 257 entries allow interpolation at the end
+const int RAMP_CURVE_SEGMENTS = 256;
+
+// This function samples one easing curve into a Q16 fixed-point table
+constexpr array<uint32_t, RAMP_CURVE_SEGMENTS + 1> build_ramp_curve_table(brightness_ramp_curve curve) {
+    array<uint32_t, RAMP_CURVE_SEGMENTS + 1> curve_table{};
+    for (int sample_index = 0; sample_index <= RAMP_CURVE_SEGMENTS; sample_index++) {
+        double progress = static_cast<double>(sample_index) / RAMP_CURVE_SEGMENTS;
+        double eased_progress = progress;
+        if (curve == RAMP_EASE_IN_OUT) {
+            eased_progress = progress * progress * (3.0 - 2.0 * progress);
+        } else if (curve == RAMP_EXPONENTIAL) {
+            // (2^(10t) - 1) / (2^10 - 1), so the curve starts at 0 and ends exactly at 1
+            eased_progress = (constexpr_exponential(progress * 10.0 * 0.69314718055994530942) - 1.0) / 1023.0;
+        }
+        curve_table[sample_index] = static_cast<uint32_t>(eased_progress * 65536.0 + 0.5);
+    }
+    return curve_table;
+}
+
+constexpr array<uint32_t, RAMP_CURVE_SEGMENTS + 1> ramp_curve_tables[] = {
+    build_ramp_curve_table(RAMP_LINEAR),
+    build_ramp_curve_table(RAMP_EASE_IN_OUT),
+    build_ramp_curve_table(RAMP_EXPONENTIAL),
+};
+static_assert(ramp_curve_tables[RAMP_EASE_IN_OUT][RAMP_CURVE_SEGMENTS / 2] == 32768, "Smoothstep is symmetric");
+static_assert(ramp_curve_tables[RAMP_EXPONENTIAL][RAMP_CURVE_SEGMENTS] == 65536, "Exponential ramp ends at full scale");
+
+// This function returns the eased Q16 progress for a Q16 linear progress, interpolating between samples
+int evaluate_ramp_curve(brightness_ramp_curve curve, uint32_t progress_q16) {
+    if (progress_q16 >= 65536) {
+        return 65536;
+    }
+    const array<uint32_t, RAMP_CURVE_SEGMENTS + 1>& curve_table = ramp_curve_tables[curve];
+    uint32_t sample_index = progress_q16 >> 8;
+    uint32_t sample_fraction = progress_q16 & 0xFF;
+    uint32_t lower_sample = curve_table[sample_index];
+    uint32_t upper_sample = curve_table[sample_index + 1];
+    return static_cast<int>(lower_sample + (((upper_sample - lower_sample) * sample_fraction) >> 8));
+}
+
+// This function returns the intensity drawn by one frame of a ramp of frame_count frames
+int compute_ramp_frame_intensity(int start_intensity, int end_intensity, long long frame_index, long long frame_count,
+                                 brightness_ramp_curve curve) {
+    long long intensity_span = end_intensity - start_intensity;
+    uint32_t progress_q16 = static_cast<uint32_t>((frame_index << 16) / frame_count);
+    int eased_progress_q16 = evaluate_ramp_curve(curve, progress_q16);
+    return start_intensity + static_cast<int>((intensity_span * eased_progress_q16 + 32768) >> 16);
+}
+
+// This function fades between two intensities, drawing one frame per absolute frame deadline
+void execute_brightness_ramp(int start_intensity, int end_intensity, milliseconds ramp_duration,
+                             brightness_ramp_curve curve, frame_pacing_statistics& pacing_statistics) {
+    int frames_per_second = launch_options.ramp_frames_per_second;
+    long long frame_count = max<long long>(1, ramp_duration.count() * frames_per_second / 1000);
+    steady_clock::time_point ramp_start = steady_clock::now();
+    
+    for (long long frame_index = 1; frame_index <= frame_count; frame_index++) {
+        // Deadlines derive from the ramp start, so a late frame never shifts the ones after it
+        steady_clock::time_point frame_deadline =
+            ramp_start + nanoseconds(frame_index * 1000000000LL / frames_per_second);
+        if (!wait_in_light_event_loop(frame_deadline)) {
+            break;
+        }
+        long long lateness = duration_cast<nanoseconds>(steady_clock::now() - frame_deadline).count();
+        
+        int frame_intensity = compute_ramp_frame_intensity(start_intensity, end_intensity, frame_index, frame_count, curve);
+        generate_illumination_pattern(PATTERN_VARIABLE_BRIGHTNESS, frame_intensity);
+        
+        // A frame is missed when drawing it ran past the deadline of the following frame
+        steady_clock::time_point next_deadline =
+            ramp_start + nanoseconds((frame_index + 1) * 1000000000LL / frames_per_second);
+        record_frame_lateness(pacing_statistics, lateness);
+        if (steady_clock::now() > next_deadline) {
+            pacing_statistics.deadlines_missed++;
+        }
+    }
+}
+
+// This function maps a lateness to its histogram bucket: one bucket per microsecond below 4 us, then
+// four per power of two, so every bucket is at most a quarter of its lower bound wide
+static int lateness_histogram_bucket(long long lateness_nanoseconds) {
+    uint64_t lateness_microseconds = static_cast<uint64_t>(max(0LL, lateness_nanoseconds) / 1000);
+    if (lateness_microseconds < 4) {
+        return static_cast<int>(lateness_microseconds);
+    }
+#if defined(__GNUC__)
+    int exponent = 63 - __builtin_clzll(lateness_microseconds);
+#else
+    int exponent = 2;
+    while ((lateness_microseconds >> (exponent + 1)) != 0) {
+        exponent++;
+    }
+#endif
+    int sub_bucket = static_cast<int>((lateness_microseconds >> (exponent - 2)) & 3);
+    return min(LATENESS_HISTOGRAM_BUCKETS - 1, (exponent - 1) * 4 + sub_bucket);
+}
+
+// This function returns the exclusive upper bound in microseconds of one histogram bucket
+static long long lateness_bucket_limit_microseconds(int bucket_index) {
+    if (bucket_index < 4) {
+        return bucket_index + 1;
+    }
+    int exponent = bucket_index / 4 + 1;
+    return (static_cast<long long>(4 + bucket_index % 4) << (exponent - 2)) + (1LL << (exponent - 2));
+}
+
+// This function adds the wake-up lateness of one frame or edge to pacing statistics
+void record_frame_lateness(frame_pacing_statistics& pacing_statistics, long long lateness_nanoseconds) {
+    pacing_statistics.frames_rendered++;
+    pacing_statistics.total_lateness_nanoseconds += max(0LL, lateness_nanoseconds);
+    pacing_statistics.maximum_lateness_nanoseconds =
+        max(pacing_statistics.maximum_lateness_nanoseconds, lateness_nanoseconds);
+    pacing_statistics.lateness_histogram[lateness_histogram_bucket(lateness_nanoseconds)]++;
+}
+
+// This function returns the lateness, rounded up to its bucket limit, that the given fraction of frames
+// did not exceed, capped at the measured maximum
+long long lateness_percentile_microseconds(const frame_pacing_statistics& pacing_statistics, double fraction) {
+    long long required_frames = max(1LL, llround(ceil(fraction * static_cast<double>(pacing_statistics.frames_rendered))));
+    long long counted_frames = 0;
+    for (int bucket_index = 0; bucket_index < LATENESS_HISTOGRAM_BUCKETS; bucket_index++) {
+        counted_frames += pacing_statistics.lateness_histogram[bucket_index];
+        if (counted_frames >= required_frames) {
+            return min(lateness_bucket_limit_microseconds(bucket_index),
+                       pacing_statistics.maximum_lateness_nanoseconds / 1000);
+        }
+    }
+    return pacing_statistics.maximum_lateness_nanoseconds / 1000;
+}
+
+// This function displays how closely animated frames followed their deadlines
+void display_frame_pacing_statistics(const frame_pacing_statistics& pacing_statistics, int frames_per_second) {
+    if (pacing_statistics.frames_rendered == 0) {
+        return;
+    }
+    console_output << "\nFRAME PACING (" << frames_per_second << " fps): "
+                   << pacing_statistics.frames_rendered << " frames, "
+                   << pacing_statistics.deadlines_missed << " missed deadlines, avg lateness "
+                   << pacing_statistics.total_lateness_nanoseconds / pacing_statistics.frames_rendered / 1000 << " us, p50 "
+                   << lateness_percentile_microseconds(pacing_statistics, 0.50) << " us, p99 "
+                   << lateness_percentile_microseconds(pacing_statistics, 0.99) << " us, max lateness "
+                   << pacing_statistics.maximum_lateness_nanoseconds / 1000 << " us" << end_line;
+}
+
+// This function appends a full-width bar drawn with one shade level
+void append_pwm_shade_bar(string& illumination_frame, int glyph_level, int intensity_level) {
+    illumination_frame += "\r[LIGHT] ";
+    replicate_glyph_to_width(illumination_frame, active_shade_glyphs[glyph_level], 60);
+    append_intensity_label(illumination_frame, intensity_level);
+}
+
+// This function holds an intensity by toggling between the two adjacent shade levels. Every wait goes
+// through the event loop, so a stop ends the hold early with the periods played so far.
+pwm_duty_statistics execute_pwm_dithered_hold(int intensity_level, milliseconds hold_duration) {
+    pwm_duty_statistics duty_statistics;
+    int clamped_intensity = min(100, max(0, intensity_level));
+    int lower_glyph_level = clamped_intensity / 25;
+    int upper_glyph_level = min(4, lower_glyph_level + 1);
+    duty_statistics.requested_intensity = clamped_intensity;
+    duty_statistics.requested_duty = (clamped_intensity % 25) / 25.0;
+    
+    // Both bar variants are rendered once; the toggling loop only emits prebuilt frames
+    string& lower_frame = render_workspace.pwm_lower_frame;
+    string& upper_frame = render_workspace.pwm_upper_frame;
+    lower_frame.clear();
+    upper_frame.clear();
+    append_pwm_shade_bar(lower_frame, lower_glyph_level, clamped_intensity);
+    append_pwm_shade_bar(upper_frame, upper_glyph_level, clamped_intensity);
+    
+    long long period_nanoseconds = 1000000000LL / launch_options.pwm_frequency_hertz;
+    long long upper_nanoseconds = (period_nanoseconds * (clamped_intensity % 25)) / 25;
+    long long period_count = max<long long>(1, duration_cast<nanoseconds>(hold_duration).count() / period_nanoseconds);
+    steady_clock::time_point hold_start = steady_clock::now();
+    
+    if (upper_nanoseconds == 0) {
+        // An exact glyph level needs no toggling at all
+        emit_illumination_frame(lower_frame, PATTERN_VARIABLE_BRIGHTNESS, clamped_intensity);
+        if (wait_in_light_event_loop(hold_start + nanoseconds(period_count * period_nanoseconds))) {
+            duty_statistics.periods_completed = period_count;
+        } else {
+            duty_statistics.periods_completed =
+                min<long long>(period_count, duration_cast<nanoseconds>(steady_clock::now() - hold_start).count() / period_nanoseconds);
+        }
+        return duty_statistics;
+    }
+    
+    // Measure the time each glyph was actually on screen, from emission to the following emission
+    long long measured_upper_nanoseconds = 0;
+    steady_clock::time_point first_emission;
+    long long periods_completed = 0;
+    while (periods_completed < period_count) {
+        steady_clock::time_point period_start = hold_start + nanoseconds(periods_completed * period_nanoseconds);
+        
+        if (!wait_in_light_event_loop(period_start)) {
+            break;
+        }
+        emit_illumination_frame(upper_frame, PATTERN_VARIABLE_BRIGHTNESS, clamped_intensity);
+        steady_clock::time_point upper_emitted = steady_clock::now();
+        if (periods_completed == 0) {
+            first_emission = upper_emitted;
+        }
+        
+        if (!wait_in_light_event_loop(period_start + nanoseconds(upper_nanoseconds))) {
+            break;
+        }
+        emit_illumination_frame(lower_frame, PATTERN_VARIABLE_BRIGHTNESS, clamped_intensity);
+        measured_upper_nanoseconds += duration_cast<nanoseconds>(steady_clock::now() - upper_emitted).count();
+        periods_completed++;
+    }
+    if (periods_completed == period_count) {
+        wait_in_light_event_loop(hold_start + nanoseconds(period_count * period_nanoseconds));
+    }
+    
+    // Only whole periods count towards the duty, so a hold cut short by a stop is measured up to its last period
+    long long measured_total_nanoseconds = periods_completed > 0
+        ? min<long long>(duration_cast<nanoseconds>(steady_clock::now() - first_emission).count(), periods_completed * period_nanoseconds)
+        : 0;
+    if (measured_total_nanoseconds > 0) {
+        duty_statistics.achieved_duty = static_cast<double>(measured_upper_nanoseconds) / measured_total_nanoseconds;
+    }
+    duty_statistics.periods_completed = periods_completed;
+    return duty_statistics;
+}
+
+// This function displays requested versus achieved duty cycles for dithered holds
+void display_pwm_duty_statistics(const pwm_duty_statistics* duty_statistics, int hold_count) {
+    console_output << "PWM DUTY CYCLE ACCURACY (" << launch_options.pwm_frequency_hertz << " Hz):" << end_line;
+    console_output << fixed_decimals(2);
+    for (int hold_index = 0; hold_index < hold_count; hold_index++) {
+        const pwm_duty_statistics& hold_statistics = duty_statistics[hold_index];
+        console_output << "  " << set_width(3) << hold_statistics.requested_intensity << "%"
+                       << " | requested duty: " << hold_statistics.requested_duty * 100.0 << "%"
+                       << " | achieved duty: " << hold_statistics.achieved_duty * 100.0 << "%"
+                       << " | error: " << (hold_statistics.achieved_duty - hold_statistics.requested_duty) * 100.0 << " pts"
+                       << " | periods: " << hold_statistics.periods_completed << end_line;
+    }
+    console_output << general_float;
+}
+
+// 8x8 Bayer matrix scaled to thresholds 1..253, so a fraction of 0 never lights and 255 always does
+const uint8_t ordered_dither_thresholds[8][8] = {
+    {  1, 129,  33, 161,   9, 137,  41, 169},
+    {193,  65, 225,  97, 201,  73, 233, 105},
+    { 49, 177,  17, 145,  57, 185,  25, 153},
+    {241, 113, 209,  81, 249, 121, 217,  89},
+    { 13, 141,  45, 173,   5, 133,  37, 165},
+    {205,  77, 237, 109, 197,  69, 229, 101},
+    { 61, 189,  29, 157,  53, 181,  21, 149},
+    {253, 125, 221,  93, 245, 117, 213,  85},
+};
+
+// This function quantizes one row of 0-255 intensities to glyph levels 0-4 with the Bayer thresholds
+void compute_ordered_dither_levels(const uint8_t* intensity_row, int row_index, int columns, uint8_t* glyph_levels) {
+    // Intensity is stretched to 0..1023: the top two bits pick the base glyph, the low byte
+    // is compared against the Bayer threshold to decide whether to step up one level
+    const uint8_t* threshold_row = ordered_dither_thresholds[row_index & 7];
+    int column_index = 0;
+    
+#ifdef __SSE2__
+    // One Bayer row is exactly eight 16-bit lanes, so a single threshold vector serves every block
+    const __m128i threshold_vector = _mm_setr_epi16(
+        threshold_row[0] - 1, threshold_row[1] - 1, threshold_row[2] - 1, threshold_row[3] - 1,
+        threshold_row[4] - 1, threshold_row[5] - 1, threshold_row[6] - 1, threshold_row[7] - 1);
+    const __m128i zero_vector = _mm_setzero_si128();
+    const __m128i fraction_mask = _mm_set1_epi16(0xFF);
+    for (; column_index + 16 <= columns; column_index += 16) {
+        __m128i intensity_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(intensity_row + column_index));
+        __m128i level_halves[2];
+        for (int half_index = 0; half_index < 2; half_index++) {
+            __m128i intensity_words = half_index == 0 ? _mm_unpacklo_epi8(intensity_bytes, zero_vector)
+                                                      : _mm_unpackhi_epi8(intensity_bytes, zero_vector);
+            // (intensity * 257) >> 6 stays within 16 bits for every 8-bit input
+            __m128i stretched = _mm_srli_epi16(_mm_add_epi16(_mm_slli_epi16(intensity_words, 8), intensity_words), 6);
+            __m128i base_level = _mm_srli_epi16(stretched, 8);
+            __m128i fraction = _mm_and_si128(stretched, fraction_mask);
+            __m128i step_up = _mm_cmpgt_epi16(fraction, threshold_vector);
+            level_halves[half_index] = _mm_sub_epi16(base_level, step_up);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(glyph_levels + column_index),
+                         _mm_packus_epi16(level_halves[0], level_halves[1]));
+    }
+#endif
+    
+    for (; column_index < columns; column_index++) {
+        int stretched = (intensity_row[column_index] * 257) >> 6;
+        glyph_levels[column_index] = static_cast<uint8_t>(
+            (stretched >> 8) + ((stretched & 0xFF) >= threshold_row[column_index & 7] ? 1 : 0));
+    }
+}
+
+// This function renders an intensity field into a screen of dithered shade glyphs drawn from the home position
+void render_ordered_dither_frame(const uint8_t* intensity_field, int columns, int rows, string& dither_frame) {
+    // Worst case is three bytes per cell plus a line break per row and the cursor escapes
+    dither_frame.resize(static_cast<size_t>(rows) * (static_cast<size_t>(columns) * 3 + 2) + 16);
+    vector<uint8_t>& glyph_levels = render_workspace.glyph_levels;
+    glyph_levels.resize(static_cast<size_t>(columns) + 16);
+    char* output_cursor = &dither_frame[0];
+    
+    memcpy(output_cursor, "\x1b" "7\x1b[H", 6); // Save the cursor and draw from the top-left corner
+    output_cursor += 6;
+    for (int row_index = 0; row_index < rows; row_index++) {
+        compute_ordered_dither_levels(intensity_field + static_cast<size_t>(row_index) * columns,
+                                      row_index, columns, glyph_levels.data());
+        for (int column_index = 0; column_index < columns; column_index++) {
+            uint8_t glyph_level = glyph_levels[column_index];
+            memcpy(output_cursor, active_shade_glyphs[glyph_level].bytes, 3);
+            output_cursor += active_shade_glyphs[glyph_level].byte_count;
+        }
+        if (row_index + 1 < rows) {
+            *output_cursor++ = '\r';
+            *output_cursor++ = '\n';
+        }
+    }
+    memcpy(output_cursor, "\x1b" "8", 2); // Return the cursor to the narration below
+    output_cursor += 2;
+    dither_frame.resize(static_cast<size_t>(output_cursor - &dither_frame[0]));
+}
+
+// This function fills the terminal area above the narration with a dithered light at the given intensity
+void append_ordered_dither_screen(string& illumination_frame, int intensity_level) {
+    int columns = detected_terminal.screen_columns;
+    int rows = max(1, detected_terminal.screen_rows - 8);
+    uint8_t field_intensity = static_cast<uint8_t>((min(100, max(0, intensity_level)) * 255 + 50) / 100);
+    vector<uint8_t>& intensity_field = render_workspace.intensity_field;
+    intensity_field.assign(static_cast<size_t>(columns) * rows, field_intensity);
+    
+    string& dither_frame = render_workspace.screen_frame;
+    render_ordered_dither_frame(intensity_field.data(), columns, rows, dither_frame);
+    illumination_frame += dither_frame;
+    illumination_frame += "\r[LIGHT]";
+    append_intensity_label(illumination_frame, intensity_level);
+}
+
+// This function measures ordered-dither rendering of a 400x120 cell screen with a moving gradient
+int execute_ordered_dither_benchmark() {
+    const int columns = 400;
+    const int rows = 120;
+    const int frame_count = 600;
+    vector<uint8_t> intensity_field(static_cast<size_t>(columns) * rows);
+    string dither_frame;
+    dither_frame.reserve(static_cast<size_t>(rows) * (columns * 3 + 2) + 16);
+    
+    console_output << "ORDERED DITHER BENCHMARK: " << columns << "x" << rows << " cells, " << frame_count << " frames" << end_line;
+#ifdef __SSE2__
+    console_output << "Inner loop: SSE2, 16 cells per iteration" << end_line;
+#else
+    console_output << "Inner loop: scalar" << end_line;
+#endif
+    
+    long long quantize_nanoseconds = 0;
+    long long render_nanoseconds = 0;
+    size_t total_bytes = 0;
+    vector<uint8_t> glyph_levels(columns + 16);
+    for (int frame_index = 0; frame_index < frame_count; frame_index++) {
+        // A diagonal gradient that drifts every frame exercises all 256 levels
+        for (int row_index = 0; row_index < rows; row_index++) {
+            for (int column_index = 0; column_index < columns; column_index++) {
+                intensity_field[static_cast<size_t>(row_index) * columns + column_index] =
+                    static_cast<uint8_t>(column_index * 255 / (columns - 1) + row_index + frame_index);
+            }
+        }
+        
+        // Time the quantizer alone, then the complete frame including glyph emission
+        steady_clock::time_point quantize_start = steady_clock::now();
+        for (int row_index = 0; row_index < rows; row_index++) {
+            compute_ordered_dither_levels(intensity_field.data() + static_cast<size_t>(row_index) * columns,
+                                          row_index, columns, glyph_levels.data());
+        }
+        steady_clock::time_point render_start = steady_clock::now();
+        render_ordered_dither_frame(intensity_field.data(), columns, rows, dither_frame);
+        steady_clock::time_point render_end = steady_clock::now();
+        
+        quantize_nanoseconds += duration_cast<nanoseconds>(render_start - quantize_start).count();
+        render_nanoseconds += duration_cast<nanoseconds>(render_end - render_start).count();
+        total_bytes += dither_frame.size();
+    }
+    
+    double cells_per_frame = static_cast<double>(columns) * rows;
+    console_output << fixed_decimals(2);
+    console_output << "Quantize: " << quantize_nanoseconds / 1000.0 / frame_count << " us/frame ("
+                   << quantize_nanoseconds / (cells_per_frame * frame_count) << " ns/cell)" << end_line;
+    console_output << "Full render: " << render_nanoseconds / 1000.0 / frame_count << " us/frame ("
+                   << render_nanoseconds / (cells_per_frame * frame_count) << " ns/cell, "
+                   << total_bytes / 1024.0 / frame_count << " KiB/frame)" << end_line;
+    console_output << "Sustainable frame rate: " << 1e9 * frame_count / render_nanoseconds << " fps" << end_line;
+    return 0;
+}
+
+// Half-angle of the beam cone and the distance over which its brightness halves, in sub-cell pixels
+const float BEAM_HALF_ANGLE_TANGENT = 0.36f;   // About 20 degrees either side of the beam axis
+const float BEAM_HALF_BRIGHTNESS_RANGE = 260.0f;
+
+// This function computes a flashlight cone with angular and distance falloff into a 0-255 field
+void compute_beam_intensity_field(int field_width, int field_height, float aim_angle, float peak_intensity,
+                                  uint8_t* intensity_field) {
+    // The lamp sits at the middle of the left edge; u runs along the beam axis, v across it
+    float axis_cosine = cos(aim_angle);
+    float axis_sine = sin(aim_angle);
+    float source_row = field_height * 0.5f;
+    float inverse_range_squared = 1.0f / (BEAM_HALF_BRIGHTNESS_RANGE * BEAM_HALF_BRIGHTNESS_RANGE);
+    
+    for (int pixel_row = 0; pixel_row < field_height; pixel_row++) {
+        float row_offset = pixel_row + 0.5f - source_row;
+        float row_along = row_offset * axis_sine;
+        float row_across = row_offset * axis_cosine;
+        uint8_t* field_row = intensity_field + static_cast<size_t>(pixel_row) * field_width;
+        int pixel_column = 0;
+        
+#ifdef __SSE2__
+        const __m128i lane_offsets = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128 along_base = _mm_set1_ps(row_along);
+        const __m128 across_base = _mm_set1_ps(row_across);
+        const __m128 cosine_vector = _mm_set1_ps(axis_cosine);
+        const __m128 sine_vector = _mm_set1_ps(axis_sine);
+        const __m128 spread_vector = _mm_set1_ps(BEAM_HALF_ANGLE_TANGENT);
+        const __m128 range_vector = _mm_set1_ps(inverse_range_squared);
+        const __m128 peak_vector = _mm_set1_ps(peak_intensity);
+        const __m128 one_vector = _mm_set1_ps(1.0f);
+        const __m128 zero_vector = _mm_setzero_ps();
+        for (; pixel_column + 4 <= field_width; pixel_column += 4) {
+            __m128 column_offset = _mm_add_ps(
+                _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(pixel_column), lane_offsets)), _mm_set1_ps(0.5f));
+            __m128 along = _mm_add_ps(_mm_mul_ps(column_offset, cosine_vector), along_base);
+            __m128 across = _mm_sub_ps(across_base, _mm_mul_ps(column_offset, sine_vector));
+            __m128 in_front = _mm_cmpgt_ps(along, zero_vector);
+            
+            // Angular falloff: 1 on the axis, 0 at the cone edge; distance falloff: 1 / (1 + (u / range)^2)
+            __m128 edge_ratio = _mm_div_ps(across, _mm_mul_ps(along, spread_vector));
+            __m128 angular = _mm_max_ps(zero_vector, _mm_sub_ps(one_vector, _mm_mul_ps(edge_ratio, edge_ratio)));
+            __m128 radial = _mm_div_ps(one_vector, _mm_add_ps(one_vector, _mm_mul_ps(_mm_mul_ps(along, along), range_vector)));
+            __m128 pixel_value = _mm_and_ps(in_front, _mm_mul_ps(peak_vector, _mm_mul_ps(angular, radial)));
+            
+            __m128i pixel_words = _mm_packs_epi32(_mm_cvttps_epi32(pixel_value), _mm_setzero_si128());
+            __m128i pixel_bytes = _mm_packus_epi16(pixel_words, _mm_setzero_si128());
+            int packed_pixels = _mm_cvtsi128_si32(pixel_bytes);
+            memcpy(field_row + pixel_column, &packed_pixels, 4);
+        }
+#endif
+        
+        for (; pixel_column < field_width; pixel_column++) {
+            float column_offset = pixel_column + 0.5f;
+            float along = column_offset * axis_cosine + row_along;
+            float across = row_across - column_offset * axis_sine;
+            float pixel_value = 0.0f;
+            if (along > 0.0f) {
+                float edge_ratio = across / (along * BEAM_HALF_ANGLE_TANGENT);
+                float angular = max(0.0f, 1.0f - edge_ratio * edge_ratio);
+                float radial = 1.0f / (1.0f + along * along * inverse_range_squared);
+                pixel_value = peak_intensity * angular * radial;
+            }
+            field_row[pixel_column] = static_cast<uint8_t>(min(255.0f, pixel_value));
+        }
+    }
+}
+
+// This function draws a 1x2 sub-cell field with upper half blocks: foreground is the top pixel, background the bottom
+void render_half_block_beam_frame(const uint8_t* intensity_field, int columns, int rows, bool palette_output,
+                                  string& beam_frame) {
+    beam_frame.assign("\x1b" "7\x1b[H");
+    for (int row_index = 0; row_index < rows; row_index++) {
+        const uint8_t* top_row = intensity_field + static_cast<size_t>(2 * row_index) * columns;
+        const uint8_t* bottom_row = top_row + columns;
+        int previous_top = -1;
+        int previous_bottom = -1;
+        
+        if (palette_output) {
+            for (int column_index = 0; column_index < columns; column_index++) {
+                // Each pixel is gamma encoded and quantized through the cached palette lookup
+                uint8_t top_value = truecolor_gamma_table[(top_row[column_index] * 100 + 127) / 255];
+                uint8_t bottom_value = truecolor_gamma_table[(bottom_row[column_index] * 100 + 127) / 255];
+                int top_color = quantize_to_xterm_palette(top_value, top_value, top_value);
+                int bottom_color = quantize_to_xterm_palette(bottom_value, bottom_value, bottom_value);
+                
+                // Equal halves become a background-only space, so runs of one color need no escapes at all
+                if (bottom_color != previous_bottom) {
+                    beam_frame += palette_background_escape_sequences[bottom_color];
+                    previous_bottom = bottom_color;
+                }
+                if (top_color == bottom_color) {
+                    beam_frame += ' ';
+                    continue;
+                }
+                if (top_color != previous_top) {
+                    beam_frame += palette_foreground_escape_sequences[top_color];
+                    previous_top = top_color;
+                }
+                beam_frame += "\xE2\x96\x80"; // ▀
+            }
+        } else {
+            for (int column_index = 0; column_index < columns; column_index++) {
+                // Escapes are emitted only when a color changes, so dark and uniform runs cost three bytes per cell
+                int top_level = (top_row[column_index] * 100 + 127) / 255;
+                int bottom_level = (bottom_row[column_index] * 100 + 127) / 255;
+                if (top_level != previous_top) {
+                    beam_frame += truecolor_foreground_escape_sequences[top_level];
+                    previous_top = top_level;
+                }
+                if (bottom_level != previous_bottom) {
+                    beam_frame += truecolor_escape_sequences[bottom_level];
+                    previous_bottom = bottom_level;
+                }
+                beam_frame += "\xE2\x96\x80"; // ▀
+            }
+        }
+        beam_frame += "\x1b[0m";
+        if (row_index + 1 < rows) {
+            beam_frame += "\r\n";
+        }
+    }
+    beam_frame += "\x1b" "8";
+}
+
+// This function draws a 2x4 sub-cell field as braille dots lit where the pixel exceeds its Bayer threshold
+void render_braille_beam_frame(const uint8_t* intensity_field, int columns, int rows, string& beam_frame) {
+    // Braille dot bits by column and row inside one cell (dots 1-2-3-7 left, 4-5-6-8 right)
+    static const uint8_t braille_dot_bits[4][2] = {{0x01, 0x08}, {0x02, 0x10}, {0x04, 0x20}, {0x40, 0x80}};
+    int field_width = columns * 2;
+    
+    beam_frame.resize(static_cast<size_t>(rows) * (static_cast<size_t>(columns) * 3 + 2) + 16);
+    char* output_cursor = &beam_frame[0];
+    memcpy(output_cursor, "\x1b" "7\x1b[H", 6);
+    output_cursor += 6;
+    
+    for (int row_index = 0; row_index < rows; row_index++) {
+        for (int column_index = 0; column_index < columns; column_index++) {
+            uint8_t dot_pattern = 0;
+            for (int dot_row = 0; dot_row < 4; dot_row++) {
+                int pixel_row = row_index * 4 + dot_row;
+                const uint8_t* field_row = intensity_field + static_cast<size_t>(pixel_row) * field_width;
+                const uint8_t* threshold_row = ordered_dither_thresholds[pixel_row & 7];
+                for (int dot_column = 0; dot_column < 2; dot_column++) {
+                    int pixel_column = column_index * 2 + dot_column;
+                    if (field_row[pixel_column] >= threshold_row[pixel_column & 7]) {
+                        dot_pattern |= braille_dot_bits[dot_row][dot_column];
+                    }
+                }
+            }
+            
+            // U+2800 + pattern encodes as E2 A0|high-bits 80|low-bits
+            *output_cursor++ = '\xE2';
+            *output_cursor++ = static_cast<char>(0xA0 | (dot_pattern >> 6));
+            *output_cursor++ = static_cast<char>(0x80 | (dot_pattern & 0x3F));
+        }
+        if (row_index + 1 < rows) {
+            *output_cursor++ = '\r';
+            *output_cursor++ = '\n';
+        }
+    }
+    memcpy(output_cursor, "\x1b" "8", 2);
+    output_cursor += 2;
+    beam_frame.resize(static_cast<size_t>(output_cursor - &beam_frame[0]));
+}
+
+// This function fills the terminal area above the narration with the beam at the given intensity
+void append_beam_screen(string& illumination_frame, int intensity_level) {
+    int columns = detected_terminal.screen_columns;
+    int rows = max(1, detected_terminal.screen_rows - 8);
+    bool braille_output = active_render_mode == RENDER_BRAILLE_BEAM;
+    int field_width = braille_output ? columns * 2 : columns;
+    int field_height = braille_output ? rows * 4 : rows * 2;
+    float peak_intensity = min(100, max(0, intensity_level)) * 2.55f;
+    
+    vector<uint8_t>& intensity_field = render_workspace.intensity_field;
+    intensity_field.resize(static_cast<size_t>(field_width) * field_height);
+    compute_beam_intensity_field(field_width, field_height, 0.0f, peak_intensity, intensity_field.data());
+    
+    string& beam_frame = render_workspace.screen_frame;
+    if (braille_output) {
+        render_braille_beam_frame(intensity_field.data(), columns, rows, beam_frame);
+    } else {
+        render_half_block_beam_frame(intensity_field.data(), columns, rows, half_block_palette_output, beam_frame);
+    }
+    illumination_frame += beam_frame;
+    illumination_frame += "\r[LIGHT]";
+    append_intensity_label(illumination_frame, intensity_level);
+}
+
+// This function measures the beam renderers on a 400x120 cell screen against the 60 fps frame budget
+int execute_beam_render_benchmark() {
+    const int columns = 400;
+    const int rows = 120;
+    const int frame_count = 240;
+    const double frame_budget_microseconds = 1000000.0 / 60.0;
+    initialize_truecolor_escape_table();
+    initialize_xterm_palette_tables();
+    
+    console_output << "BEAM RENDER BENCHMARK: " << columns << "x" << rows << " cells, " << frame_count
+                   << " frames of a sweeping beam" << end_line;
+    console_output << fixed_decimals(1);
+    
+    const char* pass_names[] = {"Half-block truecolor 1x2", "Half-block 256-color 1x2", "Braille 2x4"};
+    for (int pass_index = 0; pass_index < 3; pass_index++) {
+        bool braille_pass = pass_index == 2;
+        int field_width = braille_pass ? columns * 2 : columns;
+        int field_height = braille_pass ? rows * 4 : rows * 2;
+        vector<uint8_t> intensity_field(static_cast<size_t>(field_width) * field_height);
+        string beam_frame;
+        beam_frame.reserve(static_cast<size_t>(rows) * columns * 24);
+        long long field_nanoseconds = 0;
+        long long quantize_nanoseconds = 0;
+        size_t total_bytes = 0;
+        
+        for (int frame_index = 0; frame_index < frame_count; frame_index++) {
+            float aim_angle = 0.4f * sin(frame_index * 0.05f);
+            steady_clock::time_point field_start = steady_clock::now();
+            compute_beam_intensity_field(field_width, field_height, aim_angle, 255.0f, intensity_field.data());
+            steady_clock::time_point quantize_start = steady_clock::now();
+            if (braille_pass) {
+                render_braille_beam_frame(intensity_field.data(), columns, rows, beam_frame);
+            } else {
+                render_half_block_beam_frame(intensity_field.data(), columns, rows, pass_index == 1, beam_frame);
+            }
+            steady_clock::time_point frame_end = steady_clock::now();
+            
+            field_nanoseconds += duration_cast<nanoseconds>(quantize_start - field_start).count();
+            quantize_nanoseconds += duration_cast<nanoseconds>(frame_end - quantize_start).count();
+            total_bytes += beam_frame.size();
+        }
+        
+        double frame_microseconds = (field_nanoseconds + quantize_nanoseconds) / 1000.0 / frame_count;
+        console_output << pass_names[pass_index] << " (" << field_width << "x" << field_height
+                       << " pixels): field " << field_nanoseconds / 1000.0 / frame_count << " us, quantize "
+                       << quantize_nanoseconds / 1000.0 / frame_count << " us, total " << frame_microseconds
+                       << " us/frame, " << total_bytes / 1024.0 / frame_count << " KiB/frame -> "
+                       << (frame_microseconds < frame_budget_microseconds ? "within" : "exceeds")
+                       << " the 60 fps budget" << end_line;
+    }
+    return 0;
+}
+
+// This function builds the cached nearest-color lookup and the palette escape strings once at startup
+void initialize_xterm_palette_tables() {
+    static const int cube_levels[6] = {0, 95, 135, 175, 215, 255};
+    
+    // The 16 system colors are user-configurable, so only the cube and the grayscale ramp are matched
+    for (int red_bin = 0; red_bin < 32; red_bin++) {
+        for (int green_bin = 0; green_bin < 32; green_bin++) {
+            for (int blue_bin = 0; blue_bin < 32; blue_bin++) {
+                int channels[3] = {red_bin * 255 / 31, green_bin * 255 / 31, blue_bin * 255 / 31};
+                
+                // The cube is a product grid, so its nearest entry is the nearest level per channel
+                int cube_choice[3];
+                for (int channel = 0; channel < 3; channel++) {
+                    int best_level = 0;
+                    for (int level = 1; level < 6; level++) {
+                        if (abs(cube_levels[level] - channels[channel]) < abs(cube_levels[best_level] - channels[channel])) {
+                            best_level = level;
+                        }
+                    }
+                    cube_choice[channel] = best_level;
+                }
+                int best_index = 16 + cube_choice[0] * 36 + cube_choice[1] * 6 + cube_choice[2];
+                int best_distance = 0;
+                for (int channel = 0; channel < 3; channel++) {
+                    int difference = cube_levels[cube_choice[channel]] - channels[channel];
+                    best_distance += difference * difference;
+                }
+                
+                for (int gray_index = 232; gray_index < 256; gray_index++) {
+                    int gray_value = 8 + (gray_index - 232) * 10;
+                    int gray_distance = 0;
+                    for (int channel = 0; channel < 3; channel++) {
+                        gray_distance += (gray_value - channels[channel]) * (gray_value - channels[channel]);
+                    }
+                    if (gray_distance < best_distance) {
+                        best_distance = gray_distance;
+                        best_index = gray_index;
+                    }
+                }
+                xterm_palette_lookup[(red_bin << 10) | (green_bin << 5) | blue_bin] = static_cast<uint8_t>(best_index);
+            }
+        }
+    }
+    
+    for (int palette_index = 0; palette_index < 256; palette_index++) {
+        palette_foreground_escape_sequences[palette_index] = "\x1b[38;5;" + to_string(palette_index) + "m";
+        palette_background_escape_sequences[palette_index] = "\x1b[48;5;" + to_string(palette_index) + "m";
+    }
+    for (int intensity_level = 0; intensity_level <= 100; intensity_level++) {
+        uint8_t channel_value = truecolor_gamma_table[intensity_level];
+        palette_intensity_levels[intensity_level] = quantize_to_xterm_palette(channel_value, channel_value, channel_value);
+    }
+}
+
+// This function maps a color to its nearest xterm palette index through the cached lookup table
+uint8_t quantize_to_xterm_palette(uint8_t red, uint8_t green, uint8_t blue) {
+    return xterm_palette_lookup[((red >> 3) << 10) | ((green >> 3) << 5) | (blue >> 3)];
+}
+
+// This function appends a full-width bar whose palette background approximates the intensity
+void append_palette_illumination_bar(string& illumination_frame, int intensity_level) {
+    int clamped_intensity = min(100, max(0, intensity_level));
+    illumination_frame += palette_background_escape_sequences[palette_intensity_levels[clamped_intensity]];
+    illumination_frame.append(60, ' ');
+    illumination_frame += "\x1b[0m";
+}
+
+// This function appends a glyph repeated cell_count times using the fastest available row fill
+void replicate_glyph_to_width(string& illumination_frame, const illumination_glyph& glyph, int cell_count) {
+    if (cell_count <= 0) {
+        return;
+    }
+    size_t run_start = illumination_frame.size();
+    illumination_frame.resize(run_start + static_cast<size_t>(cell_count) * glyph.byte_count);
+    fill_glyph_row(&illumination_frame[run_start], glyph, cell_count);
+}
+
+// This function fills a preallocated buffer with a repeated glyph by doubling the already written run
+void fill_glyph_row_by_doubling(char* row_bytes, const illumination_glyph& glyph, int cell_count) {
+    size_t run_length = static_cast<size_t>(cell_count) * glyph.byte_count;
+    if (run_length == 0) {
+        return;
+    }
+    
+    // Each memcpy copies everything written so far, so a run of N glyphs needs log2(N) copies
+    memcpy(row_bytes, glyph.bytes, glyph.byte_count);
+    size_t bytes_written = glyph.byte_count;
+    while (bytes_written < run_length) {
+        size_t copy_length = min(bytes_written, run_length - bytes_written);
+        memcpy(row_bytes + bytes_written, row_bytes, copy_length);
+        bytes_written += copy_length;
+    }
+}
+
+// This function fills a preallocated buffer with a repeated glyph using 16-byte vector stores
+void fill_glyph_row(char* row_bytes, const illumination_glyph& glyph, int cell_count) {
+    size_t run_length = static_cast<size_t>(cell_count) * glyph.byte_count;
+    if (glyph.byte_count == 1) {
+        memset(row_bytes, glyph.bytes[0], run_length);
+        return;
+    }
+    
+#ifdef __SSE2__
+    // A 1, 2 or 4 byte glyph repeats every 16 bytes; a 3 byte glyph every 48 bytes (three registers)
+    alignas(16) char pattern_bytes[48] = {}; // A 16-byte pattern leaves the last two registers unwritten
+    size_t pattern_length = glyph.byte_count == 3 ? 48 : 16;
+    for (size_t pattern_index = 0; pattern_index < pattern_length; pattern_index += glyph.byte_count) {
+        memcpy(pattern_bytes + pattern_index, glyph.bytes, glyph.byte_count);
+    }
+    const __m128i pattern_first = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern_bytes));
+    const __m128i pattern_second = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern_bytes + 16));
+    const __m128i pattern_third = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern_bytes + 32));
+    
+    size_t bytes_written = 0;
+    if (pattern_length == 48) {
+        for (; bytes_written + 48 <= run_length; bytes_written += 48) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row_bytes + bytes_written), pattern_first);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row_bytes + bytes_written + 16), pattern_second);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row_bytes + bytes_written + 32), pattern_third);
+        }
+    } else {
+        for (; bytes_written + 16 <= run_length; bytes_written += 16) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row_bytes + bytes_written), pattern_first);
+        }
+    }
+    
+    // Every chunk starts on a glyph boundary, so the tail is simply the start of the pattern
+    memcpy(row_bytes + bytes_written, pattern_bytes, run_length - bytes_written);
+#else
+    fill_glyph_row_by_doubling(row_bytes, glyph, cell_count);
+#endif
+}
+
+#ifdef FLASHLIGHT_STREAM_BASELINES
+// Stream buffer that discards output, so the ostream baselines are timed without terminal I/O
+class discarding_stream_buffer : public streambuf {
+protected:
+    int overflow(int character) override { return character; }
+    streamsize xsputn(const char*, streamsize byte_count) override { return byte_count; }
+};
+#endif
+
+// This function makes a filled row look used, so a benchmark's fill is not optimized away
+static inline void keep_filled_row(const char* row_bytes) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(row_bytes) : "memory");
+#else
+    static volatile char observed_byte;
+    atomic_signal_fence(memory_order_seq_cst);
+    observed_byte = row_bytes[0];
+#endif
+}
+
+// This function compares the per-glyph loop with doubling memcpy and vector stores for wide bars. The
+// fills are timed in memory; the per-glyph loop and the vector-filled row are then both written to
+// standard output, one row after another, so the speedup includes what the real console costs. The
+// per-glyph loop is the original cout loop in builds with the stream baselines, otherwise the same
+// glyph-at-a-time writes through the console writer.
+int execute_row_fill_benchmark() {
+    const int row_widths[] = {60, 120, 250, 500, 1000, 2000, 4000};
+    const illumination_glyph& glyph = utf8_shade_glyphs[GLYPH_FULL_BLOCK];
+    vector<char> row_buffer(4000 * 4 + 64);
+    vector<double> cout_nanoseconds;
+    vector<double> doubling_nanoseconds;
+    vector<double> vector_nanoseconds;
+    vector<double> vector_write_nanoseconds;
+    
+#ifdef FLASHLIGHT_STREAM_BASELINES
+    const char* per_glyph_baseline = "cout";
+#else
+    const char* per_glyph_baseline = "console writer";
+#endif
+    console_output << "ROW FILL BENCHMARK: repeated U+2588 (3-byte UTF-8), ns per row; rows are written to standard output,"
+                   << " per-glyph baseline through " << per_glyph_baseline << end_line << flush_output;
+    for (int row_width : row_widths) {
+        int repetitions = max(200, 2000000 / row_width);
+        int console_repetitions = max(20, 200000 / row_width);
+        
+        steady_clock::time_point doubling_start = steady_clock::now();
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            fill_glyph_row_by_doubling(row_buffer.data(), glyph, row_width);
+            keep_filled_row(row_buffer.data());
+        }
+        doubling_nanoseconds.push_back(duration_cast<nanoseconds>(steady_clock::now() - doubling_start).count()
+                                       / static_cast<double>(repetitions));
+        
+        steady_clock::time_point vector_start = steady_clock::now();
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            fill_glyph_row(row_buffer.data(), glyph, row_width);
+            keep_filled_row(row_buffer.data());
+        }
+        vector_nanoseconds.push_back(duration_cast<nanoseconds>(steady_clock::now() - vector_start).count()
+                                     / static_cast<double>(repetitions));
+        
+        // The pre-existing approach: one insertion per glyph, flushed once the row is complete
+        steady_clock::time_point cout_start = steady_clock::now();
+        for (int repetition = 0; repetition < console_repetitions; repetition++) {
+#ifdef FLASHLIGHT_STREAM_BASELINES
+            for (int cell_index = 0; cell_index < row_width; cell_index++) {
+                cout << glyph.bytes;
+            }
+            cout << '\r' << flush;
+#else
+            for (int cell_index = 0; cell_index < row_width; cell_index++) {
+                console_output.write_bytes(glyph.bytes, glyph.byte_count);
+            }
+            console_output.write_bytes("\r", 1);
+            console_output.flush_buffer();
+#endif
+        }
+        cout_nanoseconds.push_back(duration_cast<nanoseconds>(steady_clock::now() - cout_start).count()
+                                   / static_cast<double>(console_repetitions));
+        
+        // The replacement: fill the row with vector stores, then hand it to the console in one write
+        steady_clock::time_point vector_write_start = steady_clock::now();
+        for (int repetition = 0; repetition < console_repetitions; repetition++) {
+            size_t row_length = static_cast<size_t>(row_width) * glyph.byte_count;
+            fill_glyph_row(row_buffer.data(), glyph, row_width);
+            row_buffer[row_length] = '\r';
+            console_output.write_bytes(row_buffer.data(), row_length + 1);
+            console_output.flush_buffer();
+        }
+        vector_write_nanoseconds.push_back(duration_cast<nanoseconds>(steady_clock::now() - vector_write_start).count()
+                                           / static_cast<double>(console_repetitions));
+    }
+    
+    console_output << "\r" << string(80, ' ') << "\r" << end_line;
+    console_output << "  width | doubling memcpy | vector stores | glyph loop to console | vector row to console | speedup"
+                   << end_line;
+    console_output << fixed_decimals(1);
+    for (size_t width_index = 0; width_index < size(row_widths); width_index++) {
+        console_output << "  " << set_width(5) << row_widths[width_index] << " | " << set_width(15)
+                       << doubling_nanoseconds[width_index] << " | " << set_width(13) << vector_nanoseconds[width_index]
+                       << " | " << set_width(21) << cout_nanoseconds[width_index] << " | " << set_width(21)
+                       << vector_write_nanoseconds[width_index] << " | " << set_width(6)
+                       << cout_nanoseconds[width_index] / vector_write_nanoseconds[width_index] << "x" << end_line;
+    }
+    console_output << general_float;
+    
+    // Both fast paths must produce byte-identical rows
+    vector<char> reference_row(4000 * 3);
+    fill_glyph_row_by_doubling(reference_row.data(), glyph, 4000);
+    fill_glyph_row(row_buffer.data(), glyph, 4000);
+    bool rows_identical = memcmp(reference_row.data(), row_buffer.data(), reference_row.size()) == 0;
+    console_output << "Vector and doubling fills identical: " << (rows_identical ? "yes" : "NO") << end_line;
+    return rows_identical ? 0 : 1;
+}
+
+// This function reserves every frame buffer for the detected screen so playback never grows them
+void prepare_render_workspace() {
+    size_t screen_cells = static_cast<size_t>(detected_terminal.screen_columns) * max(1, detected_terminal.screen_rows);
+    
+    // Braille fields hold eight pixels per cell; a truecolor half-block cell can need two escapes
+    render_workspace.intensity_field.reserve(screen_cells * 8);
+    render_workspace.glyph_levels.reserve(static_cast<size_t>(detected_terminal.screen_columns) + 16);
+    render_workspace.screen_frame.reserve(screen_cells * 48 + 64);
+    render_workspace.illumination_frame.reserve(screen_cells * 48 + 256);
+    render_workspace.pwm_lower_frame.reserve(512);
+    render_workspace.pwm_upper_frame.reserve(512);
+    
+    // Broadcast sinks swap their queued and in-flight frames, so both must hold a full screen
+    for (broadcast_sink& sink : broadcast_hub.sinks) {
+        sink.queued_frame.reserve(render_workspace.illumination_frame.capacity());
+        sink.in_flight_frame.reserve(render_workspace.illumination_frame.capacity());
+    }
+}
+
+// This function plays all four phases of the built-in sequence on the event loop under the counting
+// allocator and fails if anything allocated. On Linux a helper thread, started before counting begins,
+// keeps sending status and unknown commands through standard input and the control socket, so command
+// handling is inside the counted window as well.
+int execute_allocation_free_sequence_check() {
+    console_output << "ALLOCATION CHECK: four-phase sequence with heap allocation counting enabled" << end_line;
+    
+#ifdef __linux__
+    // Commands reach the loop from a pipe in place of standard input and from a private control socket
+    int command_pipe[2];
+    if (pipe(command_pipe) != 0 || dup2(command_pipe[0], STDIN_FILENO) < 0) {
+        console_error << "Cannot create the command pipe: " << strerror(errno) << end_line;
+        return 1;
+    }
+    close(command_pipe[0]);
+    if (launch_options.control_socket_path.empty()) {
+        launch_options.control_socket_path = "/tmp/artlest_flashlight_allocation_check_" + to_string(getpid());
+    }
+#endif
+    if (!initialize_light_event_loop()) {
+        return 1;
+    }
+    
+#ifdef __linux__
+    sockaddr_un control_address{};
+    control_address.sun_family = AF_UNIX;
+    memcpy(control_address.sun_path, launch_options.control_socket_path.c_str(), launch_options.control_socket_path.size());
+    int command_socket = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    atomic<bool> sequence_finished{false};
+    thread command_thread([&]() {
+        // The second line arrives in two writes, so partial-line assembly is exercised too
+        static const char* const command_lines[] = {"status\n", "sta", "tus\n", "unknown\n"};
+        for (size_t line_index = 0; !sequence_finished.load(); line_index = (line_index + 1) % size(command_lines)) {
+            this_thread::sleep_for(milliseconds(900));
+            ssize_t pipe_result = write(command_pipe[1], command_lines[line_index], strlen(command_lines[line_index]));
+            ssize_t send_result = sendto(command_socket, "status", 6, 0,
+                                         reinterpret_cast<const sockaddr*>(&control_address), sizeof(control_address));
+            (void)pipe_result;
+            (void)send_result;
+        }
+    });
+#endif
+    
+    counted_heap_allocations.store(0);
+    heap_allocation_counting.store(true);
+    process_flashlight_operations();
+    heap_allocation_counting.store(false);
+    long long allocation_count = counted_heap_allocations.load();
+    long long commands_handled = sequence_event_loop.commands_handled;
+    
+#ifdef __linux__
+    sequence_finished.store(true);
+    command_thread.join();
+    close(command_socket);
+    close(command_pipe[1]);
+#endif
+    shutdown_light_event_loop();
+    if (broadcast_hub.active) {
+        shutdown_frame_broadcast();
+    }
+    if (published_frame_ring != nullptr) {
+        close_light_frame_ring(launch_options.frame_ring_name, published_frame_ring);
+        published_frame_ring = nullptr;
+    }
+    
+    console_output << "\nCommands handled during the sequence: " << commands_handled << end_line;
+    console_output << "Heap allocations during the sequence: " << allocation_count << end_line;
+    console_output << "Result: " << (allocation_count == 0 ? "PASS (zero-allocation steady state)" : "FAIL") << end_line;
+    return allocation_count == 0 ? 0 : 1;
+}
+
+// This function appends the shade glyph bar of one pattern, its width following the intensity
+void append_shade_illumination_bar(string& illumination_frame, illumination_pattern_id pattern, int intensity_level) {
+    // Calculate number of illumination characters based on intensity
+    int illumination_width = (intensity_level * 60) / 100;
+    
+    // Select the shade glyph for the pattern; glyphs are multi-byte UTF-8 sequences
+    shade_glyph_level illumination_glyph_level;
+    if (pattern == PATTERN_STEADY_BRIGHT || pattern == PATTERN_VARIABLE_BRIGHTNESS) {
+        illumination_glyph_level = GLYPH_FULL_BLOCK;   // Solid block for steady illumination
+    } else if (pattern == PATTERN_STROBE_FLASH) {
+        illumination_glyph_level = GLYPH_DARK_SHADE;   // Dark shade for strobe effect
+    } else if (pattern == PATTERN_EMERGENCY_FLASH) {
+        illumination_glyph_level = GLYPH_MEDIUM_SHADE; // Medium shade for emergency signals
+    } else {
+        illumination_glyph_level = GLYPH_LIGHT_SHADE;  // Lightest shade for default
+    }
+    
+    // Compose illumination pattern for console output
+    illumination_frame += "\r[LIGHT] ";
+    replicate_glyph_to_width(illumination_frame, active_shade_glyphs[illumination_glyph_level], illumination_width);
+    append_intensity_label(illumination_frame, intensity_level);
+}
+
+// This function renders the frame of an edge's light state unless the program already holds it
+static void intern_light_state_frame(compiled_light_program& program, const timeline_edge& edge, string& state_frame) {
+    // Frames live in the same arena as the edges and are shared by every edge in that state
+    pmr::string& frame = program.state_frames[edge.pattern * 101 + edge.intensity_level];
+    if (frame.empty()) {
+        state_frame.clear();
+        if (edge.pattern == PATTERN_OFF) {
+            state_frame.append(80, ' ');
+            state_frame += "\r";
+        } else {
+            append_shade_illumination_bar(state_frame, edge.pattern, edge.intensity_level);
+        }
+        frame.assign(state_frame.data(), state_frame.size());
+    }
+}
+
+// This function expands program steps into absolute edges and renders each distinct light state once
+void compile_light_program(const light_program_step* steps, int step_count, compiled_light_program& program) {
+    // The edge total is known from the steps, so the timeline is allocated exactly once
+    size_t total_edges = program.edges.size();
+    for (int step_index = 0; step_index < step_count; step_index++) {
+        total_edges += static_cast<size_t>(steps[step_index].cycle->edge_count) * steps[step_index].repeat_count;
+    }
+    program.edges.reserve(total_edges);
+    program.state_frames.resize(5 * 101);
+    
+    string state_frame;
+    for (int step_index = 0; step_index < step_count; step_index++) {
+        const synchronized_cycle& cycle = *steps[step_index].cycle;
+        for (int repetition = 0; repetition < steps[step_index].repeat_count; repetition++) {
+            for (size_t edge_index = 0; edge_index < cycle.edge_count; edge_index++) {
+                timeline_edge edge = cycle.edges[edge_index];
+                edge.offset_microseconds += program.duration_microseconds;
+                program.edges.push_back(edge);
+                intern_light_state_frame(program, edge, state_frame);
+            }
+            program.duration_microseconds += cycle.cycle_microseconds;
+        }
+    }
+}
+
+#ifdef __linux__
+
+// Result of compiling the benchmark program in a child process
+struct program_compile_measurement {
+    double compile_milliseconds;           // Mean time to compile one session
+    double release_microseconds;           // Mean time to release one session
+    long peak_resident_kilobytes;          // Peak RSS growth over the child's starting footprint
+    long long edge_count;                  // Edges in the compiled program
+};
+
+// This function compiles the benchmark program in a fresh child so each allocator gets its own RSS peak
+static bool measure_program_compile(bool use_arena, const light_program_step* steps, int step_count,
+                                    size_t edge_count, program_compile_measurement& measurement) {
+    int result_pipe[2];
+    if (pipe(result_pipe) != 0) {
+        console_error << "Cannot create result pipe: " << strerror(errno) << end_line;
+        return false;
+    }
+    
+    console_output.flush_buffer(); // A child must not inherit and repeat buffered output
+    pid_t compile_process = fork();
+    if (compile_process == 0) {
+        close(result_pipe[0]);
+        const int session_count = 5;
+        rusage starting_usage{};
+        getrusage(RUSAGE_SELF, &starting_usage);
+        
+        program_compile_measurement child_measurement{};
+        for (int session_index = 0; session_index < session_count; session_index++) {
+            steady_clock::time_point compile_start = steady_clock::now();
+            steady_clock::time_point release_start;
+            if (use_arena) {
+                // One upstream block sized for the whole program, released when the session ends
+                light_program_session session(edge_count * sizeof(timeline_edge) + 64 * 1024);
+                compile_light_program(steps, step_count, session.program);
+                child_measurement.edge_count = static_cast<long long>(session.program.edges.size());
+                release_start = steady_clock::now();
+            } else {
+                compiled_light_program program(pmr::new_delete_resource());
+                compile_light_program(steps, step_count, program);
+                child_measurement.edge_count = static_cast<long long>(program.edges.size());
+                release_start = steady_clock::now();
+            }
+            steady_clock::time_point release_end = steady_clock::now();
+            child_measurement.compile_milliseconds +=
+                duration_cast<nanoseconds>(release_start - compile_start).count() / 1e6 / session_count;
+            child_measurement.release_microseconds +=
+                duration_cast<nanoseconds>(release_end - release_start).count() / 1e3 / session_count;
+        }
+        
+        rusage final_usage{};
+        getrusage(RUSAGE_SELF, &final_usage);
+        child_measurement.peak_resident_kilobytes = final_usage.ru_maxrss - starting_usage.ru_maxrss;
+        ssize_t write_result = write(result_pipe[1], &child_measurement, sizeof(child_measurement));
+        (void)write_result;
+        _exit(0);
+    }
+    
+    close(result_pipe[1]);
+    ssize_t read_result = compile_process > 0 ? read(result_pipe[0], &measurement, sizeof(measurement)) : -1;
+    close(result_pipe[0]);
+    if (compile_process > 0) {
+        waitpid(compile_process, nullptr, 0);
+    }
+    return read_result == static_cast<ssize_t>(sizeof(measurement));
+}
+
+// This function compares compile time and peak RSS of a large program under heap and arena allocation
+int execute_program_arena_benchmark(int edge_count) {
+    // Nine strobe cycles and one SOS cycle per block: 36 edges over 12.3 s of light
+    int block_count = max(1, edge_count / 36);
+    vector<light_program_step> steps;
+    steps.reserve(static_cast<size_t>(block_count) * 2);
+    for (int block_index = 0; block_index < block_count; block_index++) {
+        steps.push_back({&synchronized_cycles[0], 9});
+        steps.push_back({&synchronized_cycles[1], 1});
+    }
+    size_t program_edges = static_cast<size_t>(block_count) * 36;
+    
+    console_output << "LIGHT PROGRAM COMPILE BENCHMARK: " << program_edges << " edges, " << steps.size()
+                   << " steps, 5 sessions per allocator" << end_line;
+    console_output << "  allocator            | compile ms | release us | peak RSS growth" << end_line;
+    console_output << fixed_decimals(2);
+    
+    const char* allocator_names[] = {"default (new/delete)", "monotonic arena     "};
+    for (int variant = 0; variant < 2; variant++) {
+        program_compile_measurement measurement{};
+        if (!measure_program_compile(variant == 1, steps.data(), static_cast<int>(steps.size()),
+                                     program_edges, measurement)) {
+            console_error << "Compile measurement failed" << end_line;
+            return 1;
+        }
+        console_output << "  " << allocator_names[variant] << " | " << set_width(10) << measurement.compile_milliseconds
+                       << " | " << set_width(10) << measurement.release_microseconds
+                       << " | " << set_width(8) << measurement.peak_resident_kilobytes / 1024.0 << " MiB" << end_line;
+    }
+    return 0;
+}
+
+#else
+
+// This function reports that the compile benchmark relies on fork and getrusage
+int execute_program_arena_benchmark(int edge_count) {
+    (void)edge_count;
+    console_error << "The program compile benchmark is only available on Linux." << end_line;
+    return 1;
+}
+
+#endif
+
+// This function appends the " [NN%]" intensity label that closes every light bar
+void append_intensity_label(string& illumination_frame, int intensity_level) {
+    char label[16] = {' ', '['};
+    char* label_end = to_chars(label + 2, label + sizeof(label) - 2, intensity_level).ptr;
+    *label_end++ = '%';
+    *label_end++ = ']';
+    illumination_frame.append(label, static_cast<size_t>(label_end - label));
+}
+
+// This function writes formatted status text to the console in one call and flushes it
+void write_status_text(const status_text_buffer& status_text) {
+    console_output.write_bytes(status_text.text, status_text.length);
+    console_output.flush_buffer();
+}
+
+// This function reports the mean, median and 99th percentile, since single frames see wakeup effects
+static void display_format_cost_percentiles(const char* method_name, vector<long long>& samples) {
+    sort(samples.begin(), samples.end());
+    long long total_nanoseconds = 0;
+    for (long long sample : samples) {
+        total_nanoseconds += sample;
+    }
+    console_output << "  " << method_name << " | mean " << set_width(6) << total_nanoseconds / static_cast<long long>(samples.size())
+                   << " ns | median " << set_width(6) << samples[samples.size() / 2]
+                   << " ns | p99 " << set_width(6) << samples[samples.size() * 99 / 100] << " ns" << end_line;
+}
+
+// This function measures per-frame label and narration formatting through to_chars at 1 kHz, and through
+// iostream as well in builds with the stream baselines
+int execute_status_format_benchmark(int duration_seconds) {
+    int frame_count = duration_seconds * 1000;
+    vector<long long> stream_nanoseconds;
+    vector<long long> to_chars_nanoseconds;
+    stream_nanoseconds.reserve(frame_count);
+    to_chars_nanoseconds.reserve(frame_count);
+    string illumination_frame;
+    illumination_frame.reserve(256);
+    
+#ifdef FLASHLIGHT_STREAM_BASELINES
+    // Narration goes to a discarding buffer so only formatting, not the terminal, is measured
+    discarding_stream_buffer discarding_buffer;
+    ostream discarding_stream(&discarding_buffer);
+    const int method_count = 2;
+#else
+    const int method_count = 1;
+#endif
+    console_output << "STATUS FORMAT BENCHMARK: " << frame_count << " frames at 1 kHz, label + narration per frame" << end_line;
+    int console_descriptor = console_output.redirect(-1);
+    
+    steady_clock::time_point next_frame_deadline = steady_clock::now();
+    for (int frame_index = 0; frame_index < frame_count; frame_index++) {
+        next_frame_deadline += microseconds(1000);
+        wait_until_absolute_deadline(next_frame_deadline);
+        int intensity_level = frame_index % 101;
+        
+        // Alternate which method runs first so neither always pays for the cold caches after a wakeup
+        for (int method_slot = 0; method_slot < method_count; method_slot++) {
+            bool use_stream = method_count == 2 && (method_slot + frame_index) % 2 == 0;
+            steady_clock::time_point format_start = steady_clock::now();
+            illumination_frame.clear();
+            if (use_stream) {
+#ifdef FLASHLIGHT_STREAM_BASELINES
+                // The previous formatting: a temporary string per label and stream insertion per counter
+                illumination_frame += " [" + to_string(intensity_level) + "%]";
+                discarding_stream << "FLASH " << frame_index << "/" << frame_count << " - HIGH INTENSITY" << endl;
+#endif
+            } else {
+                append_intensity_label(illumination_frame, intensity_level);
+                status_text_buffer narration;
+                narration.append_text("FLASH ");
+                narration.append_number(frame_index);
+                narration.append_text("/");
+                narration.append_number(frame_count);
+                narration.append_text(" - HIGH INTENSITY\n");
+                write_status_text(narration);
+            }
+            long long format_nanoseconds = duration_cast<nanoseconds>(steady_clock::now() - format_start).count();
+            (use_stream ? stream_nanoseconds : to_chars_nanoseconds).push_back(format_nanoseconds);
+        }
+    }
+    console_output.redirect(console_descriptor);
+    
+    if (!stream_nanoseconds.empty()) {
+        display_format_cost_percentiles("iostream + to_string", stream_nanoseconds);
+    } else {
+        console_output << "  iostream baseline not built; compile with -DFLASHLIGHT_STREAM_BASELINES to compare" << end_line;
+    }
+    display_format_cost_percentiles("to_chars buffer     ", to_chars_nanoseconds);
+    return 0;
+}
+
+// Built-in SOS that repeats whole messages until interrupted: three short, three long, three short
+constexpr light_instruction sos_until_stopped_program[] = {
+    {LIGHT_OP_SET, 0, 0, 3},                                   // 0: three short flashes
+    {LIGHT_OP_EMIT, 0, PATTERN_EMERGENCY_FLASH, 100},          // 1
+    {LIGHT_OP_WAIT, 0, 0, 300000},
+    {LIGHT_OP_EMIT, 0, PATTERN_OFF, 0},
+    {LIGHT_OP_WAIT, 0, 0, 200000},
+    {LIGHT_OP_LOOP, 0, 1, 0},
+    {LIGHT_OP_SET, 0, 0, 3},                                   // 6: three long flashes
+    {LIGHT_OP_EMIT, 0, PATTERN_EMERGENCY_FLASH, 100},          // 7
+    {LIGHT_OP_WAIT, 0, 0, 800000},
+    {LIGHT_OP_EMIT, 0, PATTERN_OFF, 0},
+    {LIGHT_OP_WAIT, 0, 0, 200000},
+    {LIGHT_OP_LOOP, 0, 7, 0},
+    {LIGHT_OP_SET, 0, 0, 3},                                   // 12: three short flashes
+    {LIGHT_OP_EMIT, 0, PATTERN_EMERGENCY_FLASH, 100},          // 13
+    {LIGHT_OP_WAIT, 0, 0, 300000},
+    {LIGHT_OP_EMIT, 0, PATTERN_OFF, 0},
+    {LIGHT_OP_WAIT, 0, 0, 200000},
+    {LIGHT_OP_LOOP, 0, 13, 0},
+    {LIGHT_OP_REPEAT_UNTIL_STOPPED, 0, 0, 0},
+    {LIGHT_OP_HALT, 0, 0, 0},
+};
+
+// Built-in strobe whose intensity escalates from 20 % in 20 % steps, then holds full power for four flashes
+constexpr light_instruction escalating_strobe_program[] = {
+    {LIGHT_OP_SET, 0, 0, 20},                                  // 0
+    {LIGHT_OP_EMIT_REGISTER, 0, PATTERN_STROBE_FLASH, 0},      // 1: escalating flash
+    {LIGHT_OP_WAIT, 0, 0, 200000},
+    {LIGHT_OP_EMIT, 0, PATTERN_OFF, 0},
+    {LIGHT_OP_WAIT, 0, 0, 500000},
+    {LIGHT_OP_ADD, 0, 0, 20},
+    {LIGHT_OP_JUMP_IF_LESS, 0, 1, 101},
+    {LIGHT_OP_SET, 1, 0, 4},                                   // 7
+    {LIGHT_OP_EMIT, 0, PATTERN_STROBE_FLASH, 100},             // 8: full-power hold
+    {LIGHT_OP_WAIT, 0, 0, 200000},
+    {LIGHT_OP_EMIT, 0, PATTERN_OFF, 0},
+    {LIGHT_OP_WAIT, 0, 0, 500000},
+    {LIGHT_OP_LOOP, 1, 8, 0},
+    {LIGHT_OP_HALT, 0, 0, 0},
+};
+
+// Benchmark loop: a 1 ms sawtooth of variable-brightness edges, repeated r1 times
+constexpr light_instruction light_vm_benchmark_program[] = {
+    {LIGHT_OP_SET, 0, 0, 0},                                   // 0
+    {LIGHT_OP_EMIT_REGISTER, 0, PATTERN_VARIABLE_BRIGHTNESS, 0}, // 1
+    {LIGHT_OP_ADD, 0, 0, 1},
+    {LIGHT_OP_JUMP_IF_LESS, 0, 5, 101},
+    {LIGHT_OP_SET, 0, 0, 0},
+    {LIGHT_OP_WAIT, 0, 0, 1000},                               // 5
+    {LIGHT_OP_LOOP, 1, 1, 0},
+    {LIGHT_OP_HALT, 0, 0, 0},
+};
+
+// This function checks opcodes, registers, jump targets and operands so dispatch never has to.
+// Registers that count loops may only be set to positive values.
+constexpr bool light_program_is_well_formed(const light_instruction* program, size_t instruction_count) {
+    if (instruction_count == 0 || instruction_count > UINT16_MAX) {
+        return false;
+    }
+    unsigned loop_register_mask = 0;
+    for (size_t instruction_index = 0; instruction_index < instruction_count; instruction_index++) {
+        if (program[instruction_index].opcode == LIGHT_OP_LOOP &&
+            program[instruction_index].register_index < LIGHT_VM_REGISTER_COUNT) {
+            loop_register_mask |= 1u << program[instruction_index].register_index;
+        }
+    }
+    for (size_t instruction_index = 0; instruction_index < instruction_count; instruction_index++) {
+        const light_instruction& instruction = program[instruction_index];
+        if (instruction.opcode >= LIGHT_OPCODE_COUNT || instruction.register_index >= LIGHT_VM_REGISTER_COUNT) {
+            return false;
+        }
+        bool is_jump = instruction.opcode == LIGHT_OP_JUMP || instruction.opcode == LIGHT_OP_LOOP ||
+                       instruction.opcode == LIGHT_OP_JUMP_IF_LESS ||
+                       instruction.opcode == LIGHT_OP_REPEAT_UNTIL_STOPPED;
+        bool is_emit = instruction.opcode == LIGHT_OP_EMIT || instruction.opcode == LIGHT_OP_EMIT_REGISTER;
+        if (is_jump && instruction.operand >= instruction_count) {
+            return false;
+        }
+        if (is_emit && instruction.operand > PATTERN_VARIABLE_BRIGHTNESS) {
+            return false;
+        }
+        if (instruction.opcode == LIGHT_OP_EMIT && (instruction.immediate < 0 || instruction.immediate > 100)) {
+            return false;
+        }
+        if (instruction.opcode == LIGHT_OP_WAIT && instruction.immediate < 0) {
+            return false;
+        }
+        if (instruction.opcode == LIGHT_OP_SET && (loop_register_mask >> instruction.register_index & 1u) != 0 &&
+            instruction.immediate <= 0) {
+            return false;
+        }
+    }
+    // Execution must never run off the end of the program
+    light_opcode last_opcode = program[instruction_count - 1].opcode;
+    return last_opcode == LIGHT_OP_HALT || last_opcode == LIGHT_OP_JUMP;
+}
+
+static_assert(light_program_is_well_formed(sos_until_stopped_program, size(sos_until_stopped_program)),
+              "built-in SOS program must be well formed");
+static_assert(light_program_is_well_formed(escalating_strobe_program, size(escalating_strobe_program)),
+              "built-in escalating strobe program must be well formed");
+static_assert(light_program_is_well_formed(light_vm_benchmark_program, size(light_vm_benchmark_program)),
+              "benchmark program must be well formed");
+
+vector<light_instruction> requested_light_program;  // Program selected with --light-program
+atomic<bool> light_program_stop_requested{false};   // Set by SIGINT; ends the program at its next backward branch
+
+// This function checks a program loaded at runtime against the same rules as the built-ins
+bool validate_light_program(const light_instruction* program, size_t instruction_count) {
+    return light_program_is_well_formed(program, instruction_count);
+}
+
+// This function parses a register token of the form r0 to r7
+static bool parse_light_register(const string& token, uint8_t& register_index) {
+    if (token.size() != 2 || token[0] != 'r' || token[1] < '0' || token[1] >= '0' + LIGHT_VM_REGISTER_COUNT) {
+        return false;
+    }
+    register_index = static_cast<uint8_t>(token[1] - '0');
+    return true;
+}
+
+// This function parses an integer token; durations may carry an "ms" or "us" suffix
+static bool parse_light_value(const string& token, int32_t& value) {
+    long long parsed_value = 0;
+    const char* token_end = token.data() + token.size();
+    from_chars_result result = from_chars(token.data(), token_end, parsed_value);
+    if (result.ec != errc()) {
+        return false;
+    }
+    string_view suffix(result.ptr, static_cast<size_t>(token_end - result.ptr));
+    if (suffix == "ms") {
+        // Checked before scaling, so the multiplication cannot overflow
+        if (parsed_value < INT32_MIN / 1000 || parsed_value > INT32_MAX / 1000) {
+            return false;
+        }
+        parsed_value *= 1000;
+    } else if (!suffix.empty() && suffix != "us") {
+        return false;
+    }
+    if (parsed_value < INT32_MIN || parsed_value > INT32_MAX) {
+        return false;
+    }
+    value = static_cast<int32_t>(parsed_value);
+    return true;
+}
+
+// This function maps an assembly pattern name to its identifier
+static bool parse_light_pattern(const string& token, uint16_t& pattern) {
+    static const char* const pattern_names[] = {"off", "steady", "strobe", "emergency", "variable"};
+    for (uint16_t pattern_index = 0; pattern_index < 5; pattern_index++) {
+        if (token == pattern_names[pattern_index]) {
+            pattern = pattern_index;
+            return true;
+        }
+    }
+    return false;
+}
+
+// This function assembles a light program from a text file of one instruction per line:
+//   set rN VALUE | add rN VALUE | emit PATTERN VALUE|rN | wait DURATION|rN | jump LABEL
+//   loop rN LABEL | jump_if_less rN VALUE LABEL | repeat_until_stopped LABEL | halt | LABEL:
+// Patterns are off, steady, strobe, emergency and variable; '#' starts a comment.
+bool load_light_program_file(const string& file_path, vector<light_instruction>& program) {
+    FILE* source_file = fopen(file_path.c_str(), "r");
+    if (source_file == nullptr) {
+        console_error << "Cannot open light program " << file_path << ": " << strerror(errno) << end_line;
+        return false;
+    }
+    
+    struct label_reference {
+        size_t instruction_index;
+        string label_name;
+        int line_number;
+    };
+    vector<pair<string, size_t>> label_positions;
+    vector<label_reference> label_references;
+    program.clear();
+    
+    char line_buffer[256];
+    int line_number = 0;
+    bool parse_succeeded = true;
+    while (parse_succeeded && fgets(line_buffer, sizeof(line_buffer), source_file) != nullptr) {
+        line_number++;
+        if (char* comment_start = strchr(line_buffer, '#')) {
+            *comment_start = '\0';
+        }
+        vector<string> tokens;
+        for (char* token = strtok(line_buffer, " \t\r\n"); token != nullptr; token = strtok(nullptr, " \t\r\n")) {
+            tokens.push_back(token);
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+        
+        const string& mnemonic = tokens[0];
+        if (tokens.size() == 1 && mnemonic.size() > 1 && mnemonic.back() == ':') {
+            label_positions.push_back({mnemonic.substr(0, mnemonic.size() - 1), program.size()});
+            continue;
+        }
+        
+        light_instruction instruction{LIGHT_OP_HALT, 0, 0, 0};
+        bool operands_valid = false;
+        string jump_label;
+        if (mnemonic == "set" || mnemonic == "add") {
+            instruction.opcode = mnemonic == "set" ? LIGHT_OP_SET : LIGHT_OP_ADD;
+            operands_valid = tokens.size() == 3 && parse_light_register(tokens[1], instruction.register_index) &&
+                             parse_light_value(tokens[2], instruction.immediate);
+        } else if (mnemonic == "emit" && tokens.size() == 3) {
+            bool register_intensity = parse_light_register(tokens[2], instruction.register_index);
+            instruction.opcode = register_intensity ? LIGHT_OP_EMIT_REGISTER : LIGHT_OP_EMIT;
+            operands_valid = parse_light_pattern(tokens[1], instruction.operand) &&
+                             (register_intensity || parse_light_value(tokens[2], instruction.immediate));
+        } else if (mnemonic == "wait" && tokens.size() == 2) {
+            bool register_duration = parse_light_register(tokens[1], instruction.register_index);
+            instruction.opcode = register_duration ? LIGHT_OP_WAIT_REGISTER : LIGHT_OP_WAIT;
+            operands_valid = register_duration || parse_light_value(tokens[1], instruction.immediate);
+        } else if ((mnemonic == "jump" || mnemonic == "repeat_until_stopped") && tokens.size() == 2) {
+            instruction.opcode = mnemonic == "jump" ? LIGHT_OP_JUMP : LIGHT_OP_REPEAT_UNTIL_STOPPED;
+            jump_label = tokens[1];
+            operands_valid = true;
+        } else if (mnemonic == "loop" && tokens.size() == 3) {
+            instruction.opcode = LIGHT_OP_LOOP;
+            jump_label = tokens[2];
+            operands_valid = parse_light_register(tokens[1], instruction.register_index);
+        } else if (mnemonic == "jump_if_less" && tokens.size() == 4) {
+            instruction.opcode = LIGHT_OP_JUMP_IF_LESS;
+            jump_label = tokens[3];
+            operands_valid = parse_light_register(tokens[1], instruction.register_index) &&
+                             parse_light_value(tokens[2], instruction.immediate);
+        } else if (mnemonic == "halt" && tokens.size() == 1) {
+            operands_valid = true;
+        }
+        
+        if (!operands_valid) {
+            console_error << file_path << ":" << line_number << ": invalid instruction '" << mnemonic << "'" << end_line;
+            parse_succeeded = false;
+            break;
+        }
+        if (!jump_label.empty()) {
+            label_references.push_back({program.size(), jump_label, line_number});
+        }
+        program.push_back(instruction);
+    }
+    fclose(source_file);
+    
+    // Resolve jump labels once every label position is known
+    for (const label_reference& reference : label_references) {
+        if (!parse_succeeded) {
+            break;
+        }
+        auto label_position = find_if(label_positions.begin(), label_positions.end(),
+            [&reference](const pair<string, size_t>& label) { return label.first == reference.label_name; });
+        if (label_position == label_positions.end() || label_position->second >= program.size()) {
+            console_error << file_path << ":" << reference.line_number << ": unknown label '"
+                          << reference.label_name << "'" << end_line;
+            parse_succeeded = false;
+        } else {
+            program[reference.instruction_index].operand = static_cast<uint16_t>(label_position->second);
+        }
+    }
+    
+    if (parse_succeeded && !validate_light_program(program.data(), program.size())) {
+        console_error << file_path << ": program must end with halt or jump, keep operands in range and set loop counters above zero" << end_line;
+        parse_succeeded = false;
+    }
+    return parse_succeeded;
+}
+
+// This function selects a built-in light program by name, or assembles the named file
+bool select_light_program(const string& program_name) {
+    if (program_name == "sos-until-stopped") {
+        requested_light_program.assign(begin(sos_until_stopped_program), end(sos_until_stopped_program));
+        return true;
+    }
+    if (program_name == "escalating-strobe") {
+        requested_light_program.assign(begin(escalating_strobe_program), end(escalating_strobe_program));
+        return true;
+    }
+    return load_light_program_file(program_name, requested_light_program);
+}
+
+// This function adds the lateness of an edge that has just been drawn to optional statistics
+static void record_edge_emission_lateness(frame_pacing_statistics* emission_statistics,
+                                          steady_clock::time_point edge_deadline) {
+    if (emission_statistics != nullptr) {
+        long long emission_lateness = duration_cast<nanoseconds>(steady_clock::now() - edge_deadline).count();
+        record_frame_lateness(*emission_statistics, emission_lateness);
+    }
+}
+
+// This function shows or records one edge emitted by a light program
+static void emit_light_program_edge(illumination_pattern_id pattern, int32_t intensity_level, light_vm_state& state,
+                                    steady_clock::time_point timeline_origin,
+                                    pmr::vector<timeline_edge>* recorded_edges,
+                                    frame_pacing_statistics* emission_statistics) {
+    intensity_level = min<int32_t>(100, max<int32_t>(0, intensity_level));
+    state.edges_emitted++;
+    if (recorded_edges != nullptr) {
+        recorded_edges->push_back({state.timeline_microseconds, pattern, intensity_level});
+        return;
+    }
+    
+    // Edges are shown at absolute deadlines on the program clock, scaled by --speed, so slow frames never add drift
+    steady_clock::time_point edge_deadline = timeline_origin + microseconds(scale_program_time(state.timeline_microseconds));
+    wait_until_absolute_deadline(edge_deadline);
+    generate_illumination_pattern(pattern, pattern == PATTERN_OFF ? 0 : intensity_level);
+    record_edge_emission_lateness(emission_statistics, edge_deadline);
+}
+
+// This function clamps a register result to the int32 range, so arithmetic in assembled programs
+// saturates instead of overflowing
+static inline int32_t saturate_light_register(long long register_value) {
+    return static_cast<int32_t>(min<long long>(INT32_MAX, max<long long>(INT32_MIN, register_value)));
+}
+
+// This function interprets a validated light program until it halts. Edges are rendered at their
+// program-clock deadlines, or appended to recorded_edges without waiting when that is non-null.
+void run_light_program(const light_instruction* program, light_vm_state& state,
+                       pmr::vector<timeline_edge>* recorded_edges, frame_pacing_statistics* emission_statistics) {
+    int32_t* registers = state.registers;
+    const light_instruction* instruction = program + state.program_counter;
+    long long instructions_executed = 0;
+    steady_clock::time_point timeline_origin =
+        steady_clock::now() - microseconds(scale_program_time(state.timeline_microseconds));
+
+#ifdef __GNUC__
+    // Computed-goto dispatch: every handler jumps straight to the next handler through this table,
+    // giving each opcode its own indirect branch instead of one shared switch branch
+    static const void* const dispatch_table[LIGHT_OPCODE_COUNT] = {
+        &&execute_halt, &&execute_set, &&execute_add, &&execute_emit, &&execute_emit_register,
+        &&execute_wait, &&execute_wait_register, &&execute_jump, &&execute_loop,
+        &&execute_jump_if_less, &&execute_repeat_until_stopped,
+    };
+#define LIGHT_VM_HANDLER(handler_label, opcode_name) handler_label:
+#define LIGHT_VM_DISPATCH() instructions_executed++; goto *dispatch_table[instruction->opcode]
+    LIGHT_VM_DISPATCH();
+#else
+#define LIGHT_VM_HANDLER(handler_label, opcode_name) case opcode_name:
+#define LIGHT_VM_DISPATCH() continue
+#endif
+    // Every backward branch checks for a stop, so a loop without waits still ends on SIGINT
+#define LIGHT_VM_BRANCH(branch_target)                                                  \
+    do {                                                                                \
+        const light_instruction* target_instruction = (branch_target);                  \
+        if (target_instruction <= instruction &&                                        \
+            light_program_stop_requested.load(memory_order_relaxed)) {                  \
+            goto stop_program;                                                          \
+        }                                                                               \
+        instruction = target_instruction;                                               \
+    } while (false)
+#ifndef __GNUC__
+    for (;;) {
+        instructions_executed++;
+        switch (instruction->opcode) {
+#endif
+
+    LIGHT_VM_HANDLER(execute_set, LIGHT_OP_SET)
+        registers[instruction->register_index] = instruction->immediate;
+        instruction++;
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_add, LIGHT_OP_ADD)
+        registers[instruction->register_index] =
+            saturate_light_register(static_cast<long long>(registers[instruction->register_index]) + instruction->immediate);
+        instruction++;
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_emit, LIGHT_OP_EMIT)
+        emit_light_program_edge(static_cast<illumination_pattern_id>(instruction->operand), instruction->immediate,
+                                state, timeline_origin, recorded_edges, emission_statistics);
+        instruction++;
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_emit_register, LIGHT_OP_EMIT_REGISTER)
+        emit_light_program_edge(static_cast<illumination_pattern_id>(instruction->operand),
+                                registers[instruction->register_index],
+                                state, timeline_origin, recorded_edges, emission_statistics);
+        instruction++;
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_wait, LIGHT_OP_WAIT)
+        state.timeline_microseconds += instruction->immediate;
+        instruction++;
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_wait_register, LIGHT_OP_WAIT_REGISTER)
+        // The program clock never runs backwards: a negative duration ends the program
+        if (registers[instruction->register_index] < 0) {
+            state.negative_wait_rejected = true;
+            goto stop_program;
+        }
+        state.timeline_microseconds += registers[instruction->register_index];
+        instruction++;
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_jump, LIGHT_OP_JUMP)
+        LIGHT_VM_BRANCH(program + instruction->operand);
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_loop, LIGHT_OP_LOOP)
+        registers[instruction->register_index] =
+            saturate_light_register(static_cast<long long>(registers[instruction->register_index]) - 1);
+        LIGHT_VM_BRANCH(registers[instruction->register_index] > 0 ? program + instruction->operand : instruction + 1);
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_jump_if_less, LIGHT_OP_JUMP_IF_LESS)
+        LIGHT_VM_BRANCH(registers[instruction->register_index] < instruction->immediate
+                            ? program + instruction->operand : instruction + 1);
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_repeat_until_stopped, LIGHT_OP_REPEAT_UNTIL_STOPPED)
+        instruction = !light_program_stop_requested.load(memory_order_relaxed)
+                          ? program + instruction->operand : instruction + 1;
+        LIGHT_VM_DISPATCH();
+    
+    LIGHT_VM_HANDLER(execute_halt, LIGHT_OP_HALT)
+    stop_program:
+        state.program_counter = static_cast<size_t>(instruction - program);
+        state.instructions_executed += instructions_executed;
+        return;
+
+#ifndef __GNUC__
+        default:
+            state.program_counter = static_cast<size_t>(instruction - program);
+            state.instructions_executed += instructions_executed;
+            return;
+        }
+    }
+#endif
+#undef LIGHT_VM_HANDLER
+#undef LIGHT_VM_DISPATCH
+#undef LIGHT_VM_BRANCH
+}
+
+#ifdef __linux__
+
+// This function requests a graceful stop at the program's next backward branch
+static void request_light_program_stop(int signal_number) {
+    (void)signal_number;
+    light_program_stop_requested.store(true);
+    signal(SIGINT, SIG_DFL); // A second interrupt terminates immediately
+}
+
+#endif
+
+// This function plays the program selected with --light-program on the console
+void execute_light_program_mode() {
+    char mode_description[64];
+    snprintf(mode_description, sizeof(mode_description), "LIGHT PROGRAM: %s", launch_options.light_program_name.c_str());
+    display_operational_status(mode_description, 100);
+    console_output << "Instructions: " << requested_light_program.size() << " (Ctrl-C ends a repeating program)" << end_line;
+
+#ifdef __linux__
+    signal(SIGINT, request_light_program_stop);
+#endif
+    light_vm_state state;
+    frame_pacing_statistics emission_statistics;
+    run_light_program(requested_light_program.data(), state, nullptr, &emission_statistics);
+    generate_illumination_pattern(PATTERN_OFF, 0);
+#ifdef __linux__
+    signal(SIGINT, SIG_DFL);
+#endif
+
+    console_output << "\nLight program completed: " << state.instructions_executed << " instructions, "
+                   << state.edges_emitted << " edges, " << state.timeline_microseconds / 1000 << " ms of light" << end_line;
+    if (state.negative_wait_rejected) {
+        console_output << flush_output;
+        int wait_register = requested_light_program[state.program_counter].register_index;
+        console_error << "Light program stopped at instruction " << state.program_counter
+                      << ": wait duration in register r" << wait_register << " is negative" << end_line;
+    }
+    if (emission_statistics.frames_rendered > 0) {
+        console_output << "Edge emission lateness: avg "
+                       << emission_statistics.total_lateness_nanoseconds / emission_statistics.frames_rendered / 1000
+                       << " us, p50 " << lateness_percentile_microseconds(emission_statistics, 0.50)
+                       << " us, p99 " << lateness_percentile_microseconds(emission_statistics, 0.99)
+                       << " us, max " << emission_statistics.maximum_lateness_nanoseconds / 1000 << " us" << end_line;
+    }
+}
+
+// This function measures bytecode dispatch throughput and the lateness of rendered edges
+int execute_light_vm_benchmark() {
+    const int32_t recorded_iterations = 1000000;
+    const int32_t rendered_iterations = 2000;
+    console_output << "LIGHT PROGRAM VM BENCHMARK (" << size(light_vm_benchmark_program) << "-instruction sawtooth loop, "
+#ifdef __GNUC__
+                   << "computed-goto dispatch)" << end_line;
+#else
+                   << "switch dispatch)" << end_line;
+#endif
+    console_output << fixed_decimals(2);
+    
+    // Dispatch throughput: edges are recorded into an arena instead of waiting for their deadlines
+    double best_nanoseconds_per_instruction = 0.0;
+    light_vm_state recorded_state;
+    for (int repetition = 0; repetition < 3; repetition++) {
+        light_program_session session(static_cast<size_t>(recorded_iterations) * sizeof(timeline_edge) + 64 * 1024);
+        session.program.edges.reserve(recorded_iterations);
+        recorded_state = light_vm_state();
+        recorded_state.registers[1] = recorded_iterations;
+        
+        steady_clock::time_point run_start = steady_clock::now();
+        run_light_program(light_vm_benchmark_program, recorded_state, &session.program.edges, nullptr);
+        double run_nanoseconds = static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - run_start).count());
+        
+        double nanoseconds_per_instruction = run_nanoseconds / recorded_state.instructions_executed;
+        if (repetition == 0 || nanoseconds_per_instruction < best_nanoseconds_per_instruction) {
+            best_nanoseconds_per_instruction = nanoseconds_per_instruction;
+        }
+    }
+    console_output << "Recorded run: " << recorded_state.instructions_executed << " instructions, "
+                   << recorded_state.edges_emitted << " edges" << end_line;
+    console_output << "Dispatch: " << best_nanoseconds_per_instruction << " ns/instruction, "
+                   << 1000.0 / best_nanoseconds_per_instruction << " M instructions/s (best of 3)" << end_line;
+    
+    // Edge emission latency: the same loop rendered in real time at 1 kHz with console output discarded
+    light_vm_state rendered_state;
+    rendered_state.registers[1] = rendered_iterations;
+    frame_pacing_statistics emission_statistics;
+    int console_descriptor = console_output.redirect(-1);
+    run_light_program(light_vm_benchmark_program, rendered_state, nullptr, &emission_statistics);
+    console_output.redirect(console_descriptor);
+    
+    console_output << "Rendered run: " << rendered_state.edges_emitted << " edges at 1 kHz" << end_line;
+    console_output << "Edge emission latency (deadline to frame written): avg "
+                   << emission_statistics.total_lateness_nanoseconds / emission_statistics.frames_rendered / 1000.0
+                   << " us, max " << emission_statistics.maximum_lateness_nanoseconds / 1000.0 << " us" << end_line;
+    return 0;
+}
+
+// Longest block of edges the compaction pass tries to hoist into a repeated run
+const size_t TIMELINE_RUN_MAXIMUM_BLOCK_EDGES = 64;
+
+// This function tells whether the edges at candidate_start repeat the block at block_start shifted in time
+static bool timeline_block_repeats(const pmr::vector<timeline_edge>& edges, size_t block_start, size_t candidate_start,
+                                   size_t block_edges, long long shift_microseconds) {
+    for (size_t edge_index = 0; edge_index < block_edges; edge_index++) {
+        const timeline_edge& block_edge = edges[block_start + edge_index];
+        const timeline_edge& candidate_edge = edges[candidate_start + edge_index];
+        if (candidate_edge.pattern != block_edge.pattern || candidate_edge.intensity_level != block_edge.intensity_level ||
+            candidate_edge.offset_microseconds != block_edge.offset_microseconds + shift_microseconds) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// This function removes edges that never change what is shown and hoists repeated blocks into runs:
+// an edge replaced at the same instant is folded away, an edge redrawing the current state is merged
+// into the one before it, and a block repeating back to back at a fixed period is stored once
+void compact_light_program(const compiled_light_program& program, compacted_light_timeline& compacted,
+                           timeline_compaction_report& report) {
+    const pmr::vector<timeline_edge>& edges = program.edges;
+    report = timeline_compaction_report();
+    report.compiled_edges = edges.size();
+    
+    // The flat timeline is scratch space in the same arena as the result
+    pmr::vector<timeline_edge> flat_edges(compacted.edges.get_allocator().resource());
+    flat_edges.reserve(edges.size());
+    for (size_t edge_index = 0; edge_index < edges.size(); edge_index++) {
+        const timeline_edge& edge = edges[edge_index];
+        if (edge_index + 1 < edges.size() && edges[edge_index + 1].offset_microseconds <= edge.offset_microseconds) {
+            report.zero_length_segments_folded++;
+        } else if (!flat_edges.empty() && flat_edges.back().pattern == edge.pattern &&
+                   flat_edges.back().intensity_level == edge.intensity_level) {
+            report.equal_states_merged++;
+        } else {
+            flat_edges.push_back(edge);
+        }
+    }
+    
+    compacted.edges.clear();
+    compacted.runs.clear();
+    compacted.duration_microseconds = program.duration_microseconds;
+    size_t edge_index = 0;
+    while (edge_index < flat_edges.size()) {
+        // Pick the block length whose back-to-back repetitions starting here save the most edges
+        size_t remaining_edges = flat_edges.size() - edge_index;
+        size_t best_block_edges = 0;
+        int best_repeat_count = 1;
+        long long best_period_microseconds = 0;
+        for (size_t block_edges = 1; block_edges <= TIMELINE_RUN_MAXIMUM_BLOCK_EDGES && 2 * block_edges <= remaining_edges;
+             block_edges++) {
+            long long period_microseconds =
+                flat_edges[edge_index + block_edges].offset_microseconds - flat_edges[edge_index].offset_microseconds;
+            int repeat_count = 1;
+            while ((repeat_count + 1) * block_edges <= remaining_edges &&
+                   timeline_block_repeats(flat_edges, edge_index, edge_index + repeat_count * block_edges, block_edges,
+                                          repeat_count * period_microseconds)) {
+                repeat_count++;
+            }
+            if (repeat_count > 1 && block_edges * (repeat_count - 1) > best_block_edges * (best_repeat_count - 1)) {
+                best_block_edges = block_edges;
+                best_repeat_count = repeat_count;
+                best_period_microseconds = period_microseconds;
+            }
+        }
+        
+        if (best_repeat_count > 1) {
+            compacted.runs.push_back({compacted.edges.size(), best_block_edges, best_repeat_count, best_period_microseconds});
+            compacted.edges.insert(compacted.edges.end(), flat_edges.begin() + edge_index,
+                                   flat_edges.begin() + edge_index + best_block_edges);
+            edge_index += best_block_edges * best_repeat_count;
+            report.repeated_blocks++;
+        } else {
+            // Edges that do not repeat extend the literal run before them
+            if (compacted.runs.empty() || compacted.runs.back().repeat_count > 1) {
+                compacted.runs.push_back({compacted.edges.size(), 0, 1, 0});
+            }
+            compacted.runs.back().edge_count++;
+            compacted.edges.push_back(flat_edges[edge_index]);
+            edge_index++;
+        }
+    }
+    
+    report.flat_edges = flat_edges.size();
+    report.stored_edges = compacted.edges.size();
+    report.run_count = compacted.runs.size();
+}
+
+// This function expands the runs of a compacted timeline back into a flat edge list
+void expand_compacted_timeline(const compacted_light_timeline& compacted, pmr::vector<timeline_edge>& edges) {
+    edges.clear();
+    for (const timeline_run& run : compacted.runs) {
+        for (int repetition = 0; repetition < run.repeat_count; repetition++) {
+            for (size_t edge_index = 0; edge_index < run.edge_count; edge_index++) {
+                timeline_edge edge = compacted.edges[run.first_edge + edge_index];
+                edge.offset_microseconds += repetition * run.period_microseconds;
+                edges.push_back(edge);
+            }
+        }
+    }
+}
+
+// Phase 1 of the operational sequence: the steady light is redrawn every second, then switched off
+constexpr array<timeline_edge, 1> continuous_second_edges = {{{0, PATTERN_STEADY_BRIGHT, 100}}};
+constexpr array<timeline_edge, 1> continuous_end_edges = {{{0, PATTERN_OFF, 0}}};
+constexpr synchronized_cycle continuous_second_cycle = {"continuous", PATTERN_STEADY_BRIGHT,
+                                                        continuous_second_edges.data(), 1, 1000000};
+constexpr synchronized_cycle continuous_end_cycle = {"continuous-end", PATTERN_OFF, continuous_end_edges.data(), 1, 0};
+
+// This function appends the frames of one brightness ramp at the offsets execute_brightness_ramp draws them
+static void append_brightness_ramp_edges(compiled_light_program& program, int start_intensity, int end_intensity,
+                                         milliseconds ramp_duration, brightness_ramp_curve curve, string& state_frame) {
+    int frames_per_second = launch_options.ramp_frames_per_second;
+    long long frame_count = max<long long>(1, ramp_duration.count() * frames_per_second / 1000);
+    for (long long frame_index = 1; frame_index <= frame_count; frame_index++) {
+        timeline_edge edge = {program.duration_microseconds + frame_index * 1000000LL / frames_per_second,
+                              PATTERN_VARIABLE_BRIGHTNESS,
+                              compute_ramp_frame_intensity(start_intensity, end_intensity, frame_index, frame_count, curve)};
+        program.edges.push_back(edge);
+        intern_light_state_frame(program, edge, state_frame);
+    }
+    program.duration_microseconds += frame_count * 1000000LL / frames_per_second;
+}
+
+// This function compiles the four phases of process_flashlight_operations into one timeline, edge for
+// edge as they are drawn; console narration takes no time on the timeline and PWM holds are left out
+void compile_four_phase_sequence(compiled_light_program& program) {
+    const light_program_step steps[] = {
+        {&continuous_second_cycle, 3},
+        {&continuous_end_cycle, 1},
+        {&synchronized_cycles[0], 8},
+        {&synchronized_cycles[1], 1},
+    };
+    compile_light_program(steps, static_cast<int>(size(steps)), program);
+    
+    string state_frame;
+    int previous_brightness = 0;
+    for (const brightness_demonstration_step& step : brightness_demonstration_steps) {
+        append_brightness_ramp_edges(program, previous_brightness, step.intensity_level,
+                                     duration_cast<milliseconds>(microseconds(brightness_fade_microseconds)),
+                                     RAMP_EASE_IN_OUT, state_frame);
+        program.duration_microseconds += brightness_hold_microseconds;
+        previous_brightness = step.intensity_level;
+    }
+    append_brightness_ramp_edges(program, previous_brightness, 0, milliseconds(500), RAMP_EXPONENTIAL, state_frame);
+    
+    timeline_edge final_edge = {program.duration_microseconds, PATTERN_OFF, 0};
+    program.edges.push_back(final_edge);
+    intern_light_state_frame(program, final_edge, state_frame);
+}
+
+// This function advances a cursor to the edge in effect at an offset, or returns null before the first edge
+static const timeline_edge* find_timeline_state(const pmr::vector<timeline_edge>& edges, size_t& cursor,
+                                                long long offset_microseconds) {
+    while (cursor + 1 < edges.size() && edges[cursor + 1].offset_microseconds <= offset_microseconds) {
+        cursor++;
+    }
+    if (edges.empty() || edges[cursor].offset_microseconds > offset_microseconds) {
+        return nullptr;
+    }
+    return &edges[cursor];
+}
+
+// This function checks that two timelines show the same state at every offset where either one has an edge
+static bool timelines_show_same_light(const pmr::vector<timeline_edge>& first_edges,
+                                      const pmr::vector<timeline_edge>& second_edges) {
+    const pmr::vector<timeline_edge>* edge_lists[] = {&first_edges, &second_edges};
+    for (const pmr::vector<timeline_edge>* probe_edges : edge_lists) {
+        size_t first_cursor = 0;
+        size_t second_cursor = 0;
+        for (const timeline_edge& probe_edge : *probe_edges) {
+            const timeline_edge* first_state = find_timeline_state(first_edges, first_cursor, probe_edge.offset_microseconds);
+            const timeline_edge* second_state = find_timeline_state(second_edges, second_cursor, probe_edge.offset_microseconds);
+            if (first_state == nullptr || second_state == nullptr || first_state->pattern != second_state->pattern ||
+                first_state->intensity_level != second_state->intensity_level) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// This function compacts the built-in four-phase sequence and reports how many edges each stage removed
+int execute_timeline_compaction_report() {
+    light_program_session session(256 * 1024);
+    compile_four_phase_sequence(session.program);
+    compacted_light_timeline compacted(&session.arena);
+    timeline_compaction_report report;
+    compact_light_program(session.program, compacted, report);
+    
+    // Expanding the runs must show the same light as the compiled program, with no redundant edge left
+    pmr::vector<timeline_edge> expanded_edges(&session.arena);
+    expanded_edges.reserve(report.flat_edges);
+    expand_compacted_timeline(compacted, expanded_edges);
+    bool same_light_shown = timelines_show_same_light(session.program.edges, expanded_edges);
+    bool redundant_edges_left = expanded_edges.size() != report.flat_edges;
+    for (size_t edge_index = 1; edge_index < expanded_edges.size(); edge_index++) {
+        const timeline_edge& previous_edge = expanded_edges[edge_index - 1];
+        const timeline_edge& edge = expanded_edges[edge_index];
+        if (edge.offset_microseconds <= previous_edge.offset_microseconds ||
+            (edge.pattern == previous_edge.pattern && edge.intensity_level == previous_edge.intensity_level)) {
+            redundant_edges_left = true;
+        }
+    }
+    
+    size_t distinct_states = 0;
+    for (const pmr::string& frame : session.program.state_frames) {
+        distinct_states += frame.empty() ? 0 : 1;
+    }
+    
+    console_output << "TIMELINE COMPACTION: built-in four-phase sequence, " << session.program.duration_microseconds / 1000
+                   << " ms, ramps at " << launch_options.ramp_frames_per_second << " fps, "
+                   << distinct_states << " distinct light states" << end_line;
+    console_output << "  compiled edges                 " << set_width(6) << report.compiled_edges << end_line;
+    console_output << "  zero-length segments folded    " << set_width(6) << report.zero_length_segments_folded << end_line;
+    console_output << "  equal adjacent states merged   " << set_width(6) << report.equal_states_merged << end_line;
+    console_output << "  flat compacted edges           " << set_width(6) << report.flat_edges << end_line;
+    console_output << "  stored edges in run form       " << set_width(6) << report.stored_edges
+                   << " (" << report.run_count << " runs, " << report.repeated_blocks << " repeated blocks)" << end_line;
+    console_output << fixed_decimals(1);
+    console_output << "  edge reduction                 " << set_width(6)
+                   << 100.0 * (report.compiled_edges - report.stored_edges) / max<size_t>(1, report.compiled_edges)
+                   << " %" << end_line;
+    console_output << general_float;
+    
+    for (const timeline_run& run : compacted.runs) {
+        if (run.repeat_count > 1) {
+            const timeline_edge& first_edge = compacted.edges[run.first_edge];
+            console_output << "  run at " << set_width(6) << first_edge.offset_microseconds / 1000 << " ms: "
+                           << run.edge_count << " edges x " << run.repeat_count << " every "
+                           << run.period_microseconds / 1000 << " ms" << end_line;
+        }
+    }
+    
+    console_output << "Expanded runs: " << (same_light_shown ? "same light at every edge" : "LIGHT MISMATCH") << ", "
+                   << (redundant_edges_left ? "REDUNDANT EDGES LEFT" : "no redundant edges") << end_line;
+    return same_light_shown && !redundant_edges_left ? 0 : 1;
+}
+
+// This function samples the offset of every TIMELINE_INDEX_STRIDE-th edge of a timeline
+void build_timeline_time_index(const timeline_edge* edges, size_t edge_count, timeline_time_index& time_index) {
+    time_index.sampled_offsets.clear();
+    time_index.sampled_offsets.reserve((edge_count + TIMELINE_INDEX_STRIDE - 1) / TIMELINE_INDEX_STRIDE);
+    for (size_t edge_index = 0; edge_index < edge_count; edge_index += TIMELINE_INDEX_STRIDE) {
+        time_index.sampled_offsets.push_back(edges[edge_index].offset_microseconds);
+    }
+}
+
+// This function finds the edge in effect at an offset in O(log n): a binary search over the samples
+// picks the stride, and a binary search inside that stride picks the last edge at or before the offset
+timeline_seek_position seek_timeline(const timeline_edge* edges, size_t edge_count, const timeline_time_index& time_index,
+                                     long long offset_microseconds) {
+    if (edge_count == 0 || offset_microseconds < edges[0].offset_microseconds) {
+        return {0, 0};
+    }
+    
+    const pmr::vector<long long>& sampled_offsets = time_index.sampled_offsets;
+    size_t sample_index =
+        static_cast<size_t>(upper_bound(sampled_offsets.begin(), sampled_offsets.end(), offset_microseconds) -
+                            sampled_offsets.begin()) - 1;
+    size_t lower_edge = sample_index * TIMELINE_INDEX_STRIDE;
+    size_t upper_edge = min(edge_count, lower_edge + TIMELINE_INDEX_STRIDE);
+    while (upper_edge - lower_edge > 1) {
+        size_t middle_edge = lower_edge + (upper_edge - lower_edge) / 2;
+        if (edges[middle_edge].offset_microseconds <= offset_microseconds) {
+            lower_edge = middle_edge;
+        } else {
+            upper_edge = middle_edge;
+        }
+    }
+    return {lower_edge, offset_microseconds - edges[lower_edge].offset_microseconds};
+}
+
+// Pause state of compiled playback, shared with the signal handlers that change it
+playback_pause_control playback_pause;
+
+// This function draws a playback state and accounts the time the light was on; every state is
+// timestamped as its drawing starts, so frames that take longer to render do not bias the total
+static void show_playback_state(illumination_pattern_id pattern, int intensity_level,
+                                playback_light_statistics* light_statistics) {
+    steady_clock::time_point shown_at = steady_clock::now();
+    generate_illumination_pattern(pattern, intensity_level);
+    if (light_statistics != nullptr) {
+        if (light_statistics->light_on) {
+            light_statistics->lit_nanoseconds += duration_cast<nanoseconds>(shown_at - light_statistics->lit_since).count();
+        }
+        light_statistics->light_on = pattern != PATTERN_OFF && intensity_level > 0;
+        light_statistics->lit_since = shown_at;
+    }
+}
+
+// This function spins on steady_clock up to a deadline too close for a sleep to hit it; returns false
+// as soon as a pause is requested
+static bool spin_until_deadline_unless_paused(steady_clock::time_point deadline) {
+    while (steady_clock::now() < deadline) {
+        if (playback_pause.pause_requested.load(memory_order_relaxed)) {
+            return false;
+        }
+#ifdef __SSE2__
+        _mm_pause();
+#endif
+    }
+    return !playback_pause.pause_requested.load();
+}
+
+#ifdef __linux__
+
+// This function toggles pause from SIGUSR1; only async-signal-safe calls are made
+static void toggle_playback_pause(int signal_number) {
+    (void)signal_number;
+    playback_pause.pause_requested.store(!playback_pause.pause_requested.load());
+    uint64_t wakeup_count = 1;
+    ssize_t write_result = write(playback_pause.wakeup_descriptor, &wakeup_count, sizeof(wakeup_count));
+    (void)write_result;
+}
+
+// This function pauses from SIGTSTP and lets the playback loop stop the process once the light is dark
+static void suspend_playback(int signal_number) {
+    (void)signal_number;
+    playback_pause.stop_when_paused.store(true);
+    playback_pause.pause_requested.store(true);
+    uint64_t wakeup_count = 1;
+    ssize_t write_result = write(playback_pause.wakeup_descriptor, &wakeup_count, sizeof(wakeup_count));
+    (void)write_result;
+}
+
+// This function creates the pause wakeup descriptor and routes SIGUSR1 and Ctrl-Z to playback
+void install_playback_pause_handlers() {
+    playback_pause.pause_requested.store(false);
+    playback_pause.stop_when_paused.store(false);
+    playback_pause.wakeup_descriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    playback_pause.timer_descriptor = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    signal(SIGUSR1, toggle_playback_pause);
+    signal(SIGTSTP, suspend_playback);
+}
+
+// This function restores the default pause signals and closes the wakeup descriptor
+void remove_playback_pause_handlers() {
+    signal(SIGUSR1, SIG_DFL);
+    signal(SIGTSTP, SIG_DFL);
+    close(playback_pause.wakeup_descriptor);
+    close(playback_pause.timer_descriptor);
+    playback_pause.wakeup_descriptor = -1;
+    playback_pause.timer_descriptor = -1;
+}
+
+// This function sleeps until an absolute deadline and returns true, or returns false as soon as a pause
+// is requested. The deadline is an absolute timerfd rather than a ppoll timeout, which the kernel would
+// stretch by 0.1 % of its length; a request raised just before ppoll still ends it through the eventfd.
+// The timer fires spin_margin_microseconds early and the rest of the wait is spun.
+static bool wait_for_deadline_unless_paused(steady_clock::time_point deadline) {
+    // A sleep overshoots by tens of microseconds, which matters once segments last only a few hundred
+    steady_clock::time_point wake_time = deadline - microseconds(launch_options.spin_margin_microseconds);
+    if (deadline - steady_clock::now() < microseconds(launch_options.spin_wait_microseconds) ||
+        steady_clock::now() >= wake_time) {
+        return spin_until_deadline_unless_paused(deadline);
+    }
+    if (playback_pause.timer_descriptor < 0) {
+        wait_until_absolute_deadline(deadline);
+        return !playback_pause.pause_requested.load();
+    }
+    long long deadline_nanoseconds = duration_cast<nanoseconds>(wake_time.time_since_epoch()).count();
+    itimerspec timer_setting = {};
+    timer_setting.it_value.tv_sec = static_cast<time_t>(deadline_nanoseconds / 1000000000LL);
+    timer_setting.it_value.tv_nsec = static_cast<long>(deadline_nanoseconds % 1000000000LL);
+    if (deadline_nanoseconds <= 0) {
+        timer_setting.it_value.tv_nsec = 1; // A zero value would disarm the timer instead of firing it
+    }
+    timerfd_settime(playback_pause.timer_descriptor, TFD_TIMER_ABSTIME, &timer_setting, nullptr);
+    
+    pollfd wait_polls[2] = {{playback_pause.timer_descriptor, POLLIN, 0}, {playback_pause.wakeup_descriptor, POLLIN, 0}};
+    for (;;) {
+        if (playback_pause.pause_requested.load()) {
+            return false;
+        }
+        if (ppoll(wait_polls, 2, nullptr, nullptr) <= 0) {
+            continue;
+        }
+        uint64_t wakeup_count;
+        if (wait_polls[1].revents & POLLIN) {
+            ssize_t read_result = read(playback_pause.wakeup_descriptor, &wakeup_count, sizeof(wakeup_count));
+            (void)read_result;
+        }
+        if ((wait_polls[0].revents & POLLIN) &&
+            read(playback_pause.timer_descriptor, &wakeup_count, sizeof(wakeup_count)) > 0) {
+            return spin_until_deadline_unless_paused(deadline);
+        }
+    }
+}
+
+// This function blocks until the pause is released, stopping the process first when Ctrl-Z asked for it
+static void wait_while_playback_paused() {
+    if (playback_pause.stop_when_paused.exchange(false)) {
+        console_output << flush_output;
+        raise(SIGSTOP);
+        playback_pause.pause_requested.store(false); // Continued from the shell with fg or SIGCONT
+    }
+    pollfd wakeup_poll = {playback_pause.wakeup_descriptor, POLLIN, 0};
+    while (playback_pause.pause_requested.load()) {
+        if (ppoll(&wakeup_poll, 1, nullptr, nullptr) > 0) {
+            uint64_t wakeup_count;
+            ssize_t read_result = read(playback_pause.wakeup_descriptor, &wakeup_count, sizeof(wakeup_count));
+            (void)read_result;
+        }
+    }
+    
+    // A resume that ended ppoll with EINTR leaves its eventfd count behind; without draining it the first
+    // deadline wait after every resume takes a spurious wakeup and is rescheduled before its edge
+    uint64_t stale_wakeup_count;
+    ssize_t drain_result = read(playback_pause.wakeup_descriptor, &stale_wakeup_count, sizeof(stale_wakeup_count));
+    (void)drain_result;
+}
+
+#else
+
+// This function leaves pause unavailable where signals and ppoll are missing
+void install_playback_pause_handlers() {}
+void remove_playback_pause_handlers() {}
+
+// This function waits for the deadline; without signal support no pause can interrupt it
+static bool wait_for_deadline_unless_paused(steady_clock::time_point deadline) {
+    if (deadline - steady_clock::now() < microseconds(launch_options.spin_wait_microseconds)) {
+        return spin_until_deadline_unless_paused(deadline);
+    }
+    wait_until_absolute_deadline(deadline);
+    return true;
+}
+
+// This function returns at once; pauses are never requested on this platform
+static void wait_while_playback_paused() {}
+
+#endif
+
+// This function holds playback dark while paused and returns the timeline origin rebased to the resume
+// moment, so the rest of the interrupted segment lasts exactly as long as it had left when paused
+static steady_clock::time_point pause_compiled_playback(const compiled_light_program& program,
+                                                        const timeline_time_index& time_index,
+                                                        steady_clock::time_point timeline_origin,
+                                                        playback_light_statistics* light_statistics) {
+    steady_clock::time_point pause_start = steady_clock::now();
+    nanoseconds paused_position = pause_start - timeline_origin;
+    show_playback_state(PATTERN_OFF, 0, light_statistics);
+    
+    const pmr::vector<timeline_edge>& edges = program.edges;
+    long long paused_offset_microseconds = duration_cast<microseconds>(paused_position).count();
+    timeline_seek_position paused_at = seek_timeline(edges.data(), edges.size(), time_index, paused_offset_microseconds);
+    long long segment_end_microseconds = paused_at.edge_index + 1 < edges.size()
+        ? edges[paused_at.edge_index + 1].offset_microseconds : program.duration_microseconds;
+    console_output << "\nPaused at " << paused_offset_microseconds / 1000 << " ms with "
+                   << (segment_end_microseconds - paused_offset_microseconds) / 1000
+                   << " ms left in the current segment" << end_line;
+    
+    wait_while_playback_paused();
+    
+    // The light comes back before the console line, whose write would otherwise delay it past the rebased origin
+    steady_clock::time_point resume_time = steady_clock::now();
+    const timeline_edge& resumed_edge = edges[paused_at.edge_index];
+    show_playback_state(resumed_edge.pattern, resumed_edge.intensity_level, light_statistics);
+    if (light_statistics != nullptr) {
+        light_statistics->pause_count++;
+        light_statistics->paused_nanoseconds += duration_cast<nanoseconds>(resume_time - pause_start).count();
+    }
+    console_output << "Resumed after " << duration_cast<milliseconds>(resume_time - pause_start).count()
+                   << " ms" << end_line;
+    return resume_time - paused_position;
+}
+
+// This function plays a compiled program from an offset: the state in effect there is shown at once,
+// then every later edge at its absolute deadline, until the program's end. A pause request holds the
+// light dark and shifts the timeline origin by the time spent paused.
+void play_compiled_program(const compiled_light_program& program, const timeline_time_index& time_index,
+                           long long start_offset_microseconds, frame_pacing_statistics* emission_statistics,
+                           playback_light_statistics* light_statistics) {
+    const pmr::vector<timeline_edge>& edges = program.edges;
+    if (edges.empty()) {
+        return;
+    }
+    
+    // The origin is placed so that the start offset is now; later edges keep their spacing exactly
+    timeline_seek_position start_position = seek_timeline(edges.data(), edges.size(), time_index, start_offset_microseconds);
+    steady_clock::time_point timeline_origin = steady_clock::now() - microseconds(start_offset_microseconds);
+    show_playback_state(edges[start_position.edge_index].pattern, edges[start_position.edge_index].intensity_level,
+                        light_statistics);
+    
+    // The program end is the final deadline; it has no edge of its own to draw
+    size_t edge_index = start_position.edge_index + 1;
+    while (edge_index <= edges.size()) {
+        long long deadline_offset = edge_index < edges.size() ? edges[edge_index].offset_microseconds
+                                                              : program.duration_microseconds;
+        steady_clock::time_point edge_deadline = timeline_origin + microseconds(deadline_offset);
+        if (!wait_for_deadline_unless_paused(edge_deadline)) {
+            timeline_origin = pause_compiled_playback(program, time_index, timeline_origin, light_statistics);
+            continue;
+        }
+        if (edge_index == edges.size()) {
+            break;
+        }
+        show_playback_state(edges[edge_index].pattern, edges[edge_index].intensity_level, light_statistics);
+        record_edge_emission_lateness(emission_statistics, edge_deadline);
+        
+        // An edge is missed when it was still not drawn by the time the next one was due
+        if (emission_statistics != nullptr && edge_index + 1 < edges.size() &&
+            steady_clock::now() > timeline_origin + microseconds(edges[edge_index + 1].offset_microseconds)) {
+            emission_statistics->deadlines_missed++;
+        }
+        edge_index++;
+    }
+    
+    if (light_statistics != nullptr && light_statistics->light_on) {
+        light_statistics->lit_nanoseconds +=
+            duration_cast<nanoseconds>(steady_clock::now() - light_statistics->lit_since).count();
+        light_statistics->light_on = false;
+    }
+}
+
+// This function plays the four-phase sequence from its compiled timeline at --speed, starting --start-at
+// seconds into the sequence
+void execute_compiled_sequence_mode() {
+    light_program_session session(256 * 1024);
+    compile_four_phase_sequence(session.program);
+    long long sequence_microseconds = session.program.duration_microseconds;
+    long long start_offset_microseconds = max(0LL, launch_options.start_offset_microseconds);
+    if (start_offset_microseconds >= sequence_microseconds) {
+        console_error << "The four-phase sequence lasts only " << sequence_microseconds / 1000 << " ms." << end_line;
+        return;
+    }
+    
+    // The index is built over the scaled timeline, so the start offset is scaled the same way
+    scale_compiled_program(session.program, launch_options.playback_speed_factor);
+    start_offset_microseconds = scale_program_time(start_offset_microseconds);
+    timeline_time_index time_index(&session.arena);
+    build_timeline_time_index(session.program.edges.data(), session.program.edges.size(), time_index);
+    timeline_seek_position start_position = seek_timeline(session.program.edges.data(), session.program.edges.size(),
+                                                          time_index, start_offset_microseconds);
+    
+    display_operational_status("COMPILED FOUR-PHASE SEQUENCE", 100);
+    console_output << "Speed: " << launch_options.playback_speed_factor << "x, " << sequence_microseconds / 1000
+                   << " ms of sequence in " << session.program.duration_microseconds / 1000 << " ms" << end_line;
+    console_output << "Starting at " << start_offset_microseconds / 1000 << " of "
+                   << session.program.duration_microseconds / 1000 << " ms: edge " << start_position.edge_index + 1
+                   << " of " << session.program.edges.size() << ", "
+                   << start_position.segment_elapsed_microseconds / 1000 << " ms into its segment" << end_line;
+#ifdef __linux__
+    console_output << "Pause and resume with kill -USR1 " << getpid() << ", or Ctrl-Z and fg" << end_line;
+#endif
+    
+    frame_pacing_statistics emission_statistics;
+    playback_light_statistics light_statistics;
+    install_playback_pause_handlers();
+    play_compiled_program(session.program, time_index, start_offset_microseconds, &emission_statistics,
+                          &light_statistics);
+    remove_playback_pause_handlers();
+    generate_illumination_pattern(PATTERN_OFF, 0);
+    
+    console_output << "\nCompiled sequence completed: " << light_statistics.lit_nanoseconds / 1000000 << " ms lit, "
+                   << light_statistics.pause_count << " pauses" << end_line;
+    if (emission_statistics.frames_rendered > 0) {
+        console_output << "Edge emission lateness: avg "
+                       << emission_statistics.total_lateness_nanoseconds / emission_statistics.frames_rendered / 1000
+                       << " us, p50 " << lateness_percentile_microseconds(emission_statistics, 0.50)
+                       << " us, p99 " << lateness_percentile_microseconds(emission_statistics, 0.99)
+                       << " us, max " << emission_statistics.maximum_lateness_nanoseconds / 1000 << " us" << end_line;
+    }
+}
+
+// This function orders an offset before an edge for upper_bound over a whole edge list
+static bool offset_precedes_edge(long long offset_microseconds, const timeline_edge& edge) {
+    return offset_microseconds < edge.offset_microseconds;
+}
+
+// This function compares seeking by replay from the start, by binary search over every edge and by the
+// sparse time index, at random offsets of a large program
+int execute_timeline_seek_benchmark(int edge_count) {
+    // Nine strobe cycles and one SOS cycle per block give the edges uneven spacing
+    int block_count = max(1, edge_count / 36);
+    vector<light_program_step> steps;
+    steps.reserve(static_cast<size_t>(block_count) * 2);
+    for (int block_index = 0; block_index < block_count; block_index++) {
+        steps.push_back({&synchronized_cycles[0], 9});
+        steps.push_back({&synchronized_cycles[1], 1});
+    }
+    size_t program_edges = static_cast<size_t>(block_count) * 36;
+    light_program_session session(program_edges * sizeof(timeline_edge) + 64 * 1024);
+    compile_light_program(steps.data(), static_cast<int>(steps.size()), session.program);
+    const timeline_edge* edges = session.program.edges.data();
+    size_t total_edges = session.program.edges.size();
+    long long duration_microseconds = session.program.duration_microseconds;
+    
+    timeline_time_index time_index(&session.arena);
+    steady_clock::time_point build_start = steady_clock::now();
+    build_timeline_time_index(edges, total_edges, time_index);
+    double build_milliseconds = duration_cast<nanoseconds>(steady_clock::now() - build_start).count() / 1e6;
+    
+    // Offsets spread over the whole program by a fixed-seed xorshift generator
+    const size_t seek_count = 1000000;
+    const size_t replay_seek_count = 100;
+    vector<long long> seek_offsets(seek_count);
+    uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+    for (long long& seek_offset : seek_offsets) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        seek_offset = static_cast<long long>(random_state % static_cast<uint64_t>(duration_microseconds));
+    }
+    vector<size_t> indexed_results(seek_count);
+    vector<size_t> binary_results(seek_count);
+    vector<size_t> replay_results(replay_seek_count);
+    
+    steady_clock::time_point replay_start = steady_clock::now();
+    for (size_t seek_index = 0; seek_index < replay_seek_count; seek_index++) {
+        size_t edge_index = 0;
+        while (edge_index + 1 < total_edges && edges[edge_index + 1].offset_microseconds <= seek_offsets[seek_index]) {
+            edge_index++;
+        }
+        replay_results[seek_index] = edge_index;
+    }
+    double replay_nanoseconds = duration_cast<nanoseconds>(steady_clock::now() - replay_start).count() /
+                                static_cast<double>(replay_seek_count);
+    
+    steady_clock::time_point binary_start = steady_clock::now();
+    for (size_t seek_index = 0; seek_index < seek_count; seek_index++) {
+        binary_results[seek_index] = static_cast<size_t>(
+            upper_bound(edges, edges + total_edges, seek_offsets[seek_index], offset_precedes_edge) - edges) - 1;
+    }
+    double binary_nanoseconds = duration_cast<nanoseconds>(steady_clock::now() - binary_start).count() /
+                                static_cast<double>(seek_count);
+    
+    steady_clock::time_point indexed_start = steady_clock::now();
+    for (size_t seek_index = 0; seek_index < seek_count; seek_index++) {
+        indexed_results[seek_index] = seek_timeline(edges, total_edges, time_index, seek_offsets[seek_index]).edge_index;
+    }
+    double indexed_nanoseconds = duration_cast<nanoseconds>(steady_clock::now() - indexed_start).count() /
+                                 static_cast<double>(seek_count);
+    
+    bool results_agree = binary_results == indexed_results;
+    for (size_t seek_index = 0; seek_index < replay_seek_count; seek_index++) {
+        results_agree = results_agree && replay_results[seek_index] == indexed_results[seek_index];
+    }
+    
+    console_output << fixed_decimals(1);
+    console_output << "TIMELINE SEEK BENCHMARK: " << total_edges << " edges, "
+                   << duration_microseconds / 3600e6 << " hours of light" << end_line;
+    console_output << "Time index: " << time_index.sampled_offsets.size() << " samples (one per "
+                   << TIMELINE_INDEX_STRIDE << " edges), "
+                   << time_index.sampled_offsets.size() * sizeof(long long) / 1024.0 << " KiB, built in "
+                   << build_milliseconds << " ms" << end_line;
+    console_output << "  method                       |   seeks | ns/seek" << end_line;
+    console_output << "  replay from the start        | " << set_width(7) << replay_seek_count << " | "
+                   << set_width(7) << replay_nanoseconds << end_line;
+    console_output << "  binary search over all edges | " << set_width(7) << seek_count << " | "
+                   << set_width(7) << binary_nanoseconds << end_line;
+    console_output << "  sparse time index            | " << set_width(7) << seek_count << " | "
+                   << set_width(7) << indexed_nanoseconds << end_line;
+    console_output << "Seek results agree: " << (results_agree ? "yes" : "NO") << end_line;
+    return results_agree ? 0 : 1;
+}
+
+// This function sums the time a timeline shows any state other than off
+static long long timeline_lit_microseconds(const compiled_light_program& program) {
+    long long lit_microseconds = 0;
+    for (size_t edge_index = 0; edge_index < program.edges.size(); edge_index++) {
+        const timeline_edge& edge = program.edges[edge_index];
+        long long segment_end = edge_index + 1 < program.edges.size() ? program.edges[edge_index + 1].offset_microseconds
+                                                                      : program.duration_microseconds;
+        if (edge.pattern != PATTERN_OFF && edge.intensity_level > 0) {
+            lit_microseconds += segment_end - edge.offset_microseconds;
+        }
+    }
+    return lit_microseconds;
+}
+
+#ifdef __linux__
+
+// This function sends pause and resume requests to the playback thread in the middle of strobe flashes
+static void drive_pause_requests(pthread_t playback_thread, steady_clock::time_point playback_start, int pause_count,
+                                 milliseconds pause_duration) {
+    const synchronized_cycle& strobe_cycle = synchronized_cycles[0];
+    long long flash_middle = strobe_cycle_segments[0].duration_microseconds / 2;
+    for (int pause_index = 0; pause_index < pause_count; pause_index++) {
+        // Earlier pauses shifted the timeline by their length, so the wall clock target moves with them
+        this_thread::sleep_until(playback_start + microseconds((pause_index + 1) * strobe_cycle.cycle_microseconds +
+                                                               flash_middle) + pause_index * pause_duration);
+        pthread_kill(playback_thread, SIGUSR1);
+        this_thread::sleep_for(pause_duration);
+        pthread_kill(playback_thread, SIGUSR1);
+    }
+}
+
+// This function plays a strobe once straight through and once paused mid-flash pause_count times, and
+// checks that the paused run still shows the timeline's lit time. The error may exceed the undisturbed
+// run's edge lateness by a fixed 500 us per pause; a pause that restarted or skipped the rest of its flash
+// would miss by half a flash per pause.
+int execute_pause_resume_test(int pause_count) {
+    // One undisturbed flash before the first pause and after the last one
+    light_program_session session(64 * 1024);
+    const light_program_step steps[] = {{&synchronized_cycles[0], pause_count + 2}};
+    compile_light_program(steps, 1, session.program);
+    timeline_time_index time_index(&session.arena);
+    build_timeline_time_index(session.program.edges.data(), session.program.edges.size(), time_index);
+    long long expected_lit_microseconds = timeline_lit_microseconds(session.program);
+    const milliseconds pause_duration(150);
+    
+    console_output << "PAUSE/RESUME TEST: " << pause_count + 2 << " strobe cycles, " << pause_count
+                   << " pauses of " << pause_duration.count() << " ms in the middle of flashes" << end_line;
+    console_output << flush_output;
+    install_playback_pause_handlers();
+    int console_descriptor = console_output.redirect(-1);
+    
+    playback_light_statistics reference_statistics;
+    frame_pacing_statistics reference_emission;
+    play_compiled_program(session.program, time_index, 0, &reference_emission, &reference_statistics);
+    
+    playback_light_statistics paused_statistics;
+    frame_pacing_statistics paused_emission;
+    steady_clock::time_point playback_start = steady_clock::now();
+    thread pause_driver(drive_pause_requests, pthread_self(), playback_start, pause_count, pause_duration);
+    play_compiled_program(session.program, time_index, 0, &paused_emission, &paused_statistics);
+    steady_clock::time_point playback_end = steady_clock::now();
+    pause_driver.join();
+    
+    console_output.redirect(console_descriptor);
+    remove_playback_pause_handlers();
+    
+    double reference_error = (reference_statistics.lit_nanoseconds - expected_lit_microseconds * 1000) / 1e3;
+    double paused_error = (paused_statistics.lit_nanoseconds - expected_lit_microseconds * 1000) / 1e3;
+    double tolerance_microseconds = 500.0 * pause_count + reference_emission.total_lateness_nanoseconds / 1e3;
+    bool pauses_observed = paused_statistics.pause_count == pause_count;
+    bool lit_time_kept = fabs(paused_error) <= tolerance_microseconds;
+    
+    console_output << fixed_decimals(1);
+    console_output << "Timeline lit time:         " << expected_lit_microseconds / 1000.0 << " ms" << end_line;
+    console_output << "Without pauses:            " << reference_statistics.lit_nanoseconds / 1e6 << " ms lit ("
+                   << reference_error << " us error)" << end_line;
+    console_output << "With " << set_width(2) << paused_statistics.pause_count << " pauses:            "
+                   << paused_statistics.lit_nanoseconds / 1e6 << " ms lit (" << paused_error << " us error), "
+                   << paused_statistics.paused_nanoseconds / 1e6 << " ms paused" << end_line;
+    console_output << "Playback length:           "
+                   << duration_cast<nanoseconds>(playback_end - playback_start).count() / 1e6 << " ms for "
+                   << session.program.duration_microseconds / 1000.0 << " ms of timeline" << end_line;
+    console_output << "Edge lateness:             " << reference_emission.total_lateness_nanoseconds / 1e3
+                   << " us total without pauses, " << paused_emission.total_lateness_nanoseconds / 1e3
+                   << " us with them ("
+                   << (paused_emission.total_lateness_nanoseconds - reference_emission.total_lateness_nanoseconds) / 1e3 / pause_count
+                   << " us added per resume)" << end_line;
+    console_output << "Result: " << (pauses_observed && lit_time_kept ? "PASS" : "FAIL") << " (tolerance "
+                   << tolerance_microseconds << " us)" << end_line;
+    return pauses_observed && lit_time_kept ? 0 : 1;
+}
+
+#else
+
+// This function reports that the pause test relies on signals and ppoll
+int execute_pause_resume_test(int pause_count) {
+    (void)pause_count;
+    console_error << "The pause/resume test is only available on Linux." << end_line;
+    return 1;
+}
+
+#endif
+
+// This function converts program time into playback time at the --speed factor
+long long scale_program_time(long long program_microseconds) {
+    return llround(static_cast<double>(program_microseconds) / launch_options.playback_speed_factor);
+}
+
+// This function rescales a compiled timeline so it plays speed_factor times faster. Every absolute offset
+// is rounded on its own, so rounding never accumulates into drift over long programs.
+void scale_compiled_program(compiled_light_program& program, double speed_factor) {
+    for (timeline_edge& edge : program.edges) {
+        edge.offset_microseconds = llround(static_cast<double>(edge.offset_microseconds) / speed_factor);
+    }
+    program.duration_microseconds = llround(static_cast<double>(program.duration_microseconds) / speed_factor);
+}
+
+// This function returns the user and system CPU time consumed by this process so far
+static long long process_cpu_microseconds() {
+#ifdef __linux__
+    rusage process_usage{};
+    getrusage(RUSAGE_SELF, &process_usage);
+    return (process_usage.ru_utime.tv_sec + process_usage.ru_stime.tv_sec) * 1000000LL +
+           process_usage.ru_utime.tv_usec + process_usage.ru_stime.tv_usec;
+#else
+    return 0;
+#endif
+}
+
+// This function plays the compiled four-phase sequence at high speed factors, sleeping for every wait and
+// then spinning out the short ones, and compares edge lateness and CPU time
+int execute_playback_speed_benchmark() {
+    const double speed_factors[] = {10.0, 30.0, 100.0};
+    int configured_spin_microseconds = launch_options.spin_wait_microseconds;
+    int configured_margin_microseconds = launch_options.spin_margin_microseconds;
+    double configured_speed_factor = launch_options.playback_speed_factor;
+    
+    console_output << "PLAYBACK SPEED BENCHMARK: compiled four-phase sequence, console output discarded" << end_line;
+    console_output << "  speed | shortest segment | waits              | missed | avg late us | max late us | CPU ms" << end_line;
+    console_output << fixed_decimals(1);
+    install_playback_pause_handlers();
+    for (double speed_factor : speed_factors) {
+        light_program_session session(256 * 1024);
+        compile_four_phase_sequence(session.program);
+        scale_compiled_program(session.program, speed_factor);
+        timeline_time_index time_index(&session.arena);
+        build_timeline_time_index(session.program.edges.data(), session.program.edges.size(), time_index);
+        long long shortest_segment_microseconds = session.program.duration_microseconds;
+        for (size_t edge_index = 1; edge_index < session.program.edges.size(); edge_index++) {
+            long long segment_microseconds = session.program.edges[edge_index].offset_microseconds -
+                                             session.program.edges[edge_index - 1].offset_microseconds;
+            if (segment_microseconds > 0) {
+                shortest_segment_microseconds = min(shortest_segment_microseconds, segment_microseconds);
+            }
+        }
+        
+        for (int spin_variant = 0; spin_variant < 2; spin_variant++) {
+            launch_options.spin_wait_microseconds = spin_variant == 0 ? 0 : max(1, configured_spin_microseconds);
+            launch_options.spin_margin_microseconds = spin_variant == 0 ? 0 : configured_margin_microseconds;
+            launch_options.playback_speed_factor = speed_factor;
+            frame_pacing_statistics emission_statistics;
+            int console_descriptor = console_output.redirect(-1);
+            long long cpu_start = process_cpu_microseconds();
+            play_compiled_program(session.program, time_index, 0, &emission_statistics, nullptr);
+            long long cpu_used = process_cpu_microseconds() - cpu_start;
+            console_output.redirect(console_descriptor);
+            
+            char wait_description[32];
+            snprintf(wait_description, sizeof(wait_description), spin_variant == 0 ? "sleep only" : "spin below %d us",
+                     launch_options.spin_wait_microseconds);
+            console_output << set_width(6) << speed_factor << "x | " << set_width(13) << shortest_segment_microseconds
+                           << " us | " << wait_description << string(18 - min<size_t>(18, strlen(wait_description)), ' ')
+                           << " | " << set_width(6) << emission_statistics.deadlines_missed << " | " << set_width(11)
+                           << emission_statistics.total_lateness_nanoseconds / max(1LL, emission_statistics.frames_rendered) / 1e3
+                           << " | " << set_width(11) << emission_statistics.maximum_lateness_nanoseconds / 1e3
+                           << " | " << set_width(6) << cpu_used / 1e3 << end_line;
+        }
+    }
+    remove_playback_pause_handlers();
+    launch_options.spin_wait_microseconds = configured_spin_microseconds;
+    launch_options.spin_margin_microseconds = configured_margin_microseconds;
+    launch_options.playback_speed_factor = configured_speed_factor;
+    return 0;
+}
+
+// This function waits for a periodic absolute deadline until the run duration has passed, recording the
+// lateness of every wake-up; a tick is missed when it wakes after the following tick was due
+static void measure_periodic_wakeups(microseconds period, milliseconds run_duration,
+                                     frame_pacing_statistics& pacing_statistics) {
+    steady_clock::time_point run_start = steady_clock::now();
+    long long tick_count = duration_cast<microseconds>(run_duration).count() / period.count();
+    for (long long tick_index = 1; tick_index <= tick_count; tick_index++) {
+        steady_clock::time_point tick_deadline = run_start + period * tick_index;
+        wait_until_absolute_deadline(tick_deadline);
+        steady_clock::time_point wake_time = steady_clock::now();
+        record_frame_lateness(pacing_statistics, duration_cast<nanoseconds>(wake_time - tick_deadline).count());
+        if (wake_time >= tick_deadline + period) {
+            pacing_statistics.deadlines_missed++;
+        }
+    }
+}
+
+// This function ticks a periodic absolute deadline for a while under several wait strategies, from
+// sleeping the whole wait through hybrid sleep-then-spin margins to spinning throughout, and reports
+// the lateness percentiles of each strategy against the CPU time it burned
+int execute_deadline_waiter_benchmark() {
+    const int period_microseconds[] = {1000, 10000};
+    const int margin_microseconds[] = {0, 50, 100, 200, 500, -1};
+    const milliseconds run_duration(1000);
+    int configured_margin_microseconds = launch_options.spin_margin_microseconds;
+    
+    console_output << "DEADLINE WAITER BENCHMARK: " << run_duration.count() << " ms per row, lateness from deadline to wake-up"
+                   << end_line;
+    console_output << "  period | wait                | ticks | p50 us | p99 us | max us | CPU %" << end_line;
+    for (int period : period_microseconds) {
+        for (int margin : margin_microseconds) {
+            // A margin of a whole period never sleeps, which is the pure spin reference
+            launch_options.spin_margin_microseconds = margin < 0 ? period : margin;
+            frame_pacing_statistics pacing_statistics;
+            steady_clock::time_point run_start = steady_clock::now();
+            long long cpu_start = process_cpu_microseconds();
+            measure_periodic_wakeups(microseconds(period), run_duration, pacing_statistics);
+            long long cpu_used = process_cpu_microseconds() - cpu_start;
+            long long wall_used = duration_cast<microseconds>(steady_clock::now() - run_start).count();
+            
+            char wait_description[32];
+            if (margin == 0) {
+                snprintf(wait_description, sizeof(wait_description), "sleep only");
+            } else if (margin < 0) {
+                snprintf(wait_description, sizeof(wait_description), "spin only");
+            } else {
+                snprintf(wait_description, sizeof(wait_description), "sleep + %d us spin", margin);
+            }
+            console_output << set_width(5) << period / 1000 << " ms | " << wait_description
+                           << string(19 - min<size_t>(19, strlen(wait_description)), ' ') << " | " << set_width(5)
+                           << pacing_statistics.frames_rendered << " | " << set_width(6)
+                           << lateness_percentile_microseconds(pacing_statistics, 0.50) << " | " << set_width(6)
+                           << lateness_percentile_microseconds(pacing_statistics, 0.99) << " | " << set_width(6)
+                           << pacing_statistics.maximum_lateness_nanoseconds / 1000 << " | " << fixed_decimals(1)
+                           << set_width(5) << 100.0 * cpu_used / max(1LL, wall_used) << general_float << end_line;
+        }
+    }
+    launch_options.spin_margin_microseconds = configured_margin_microseconds;
+    return 0;
+}
+
+#ifdef __linux__
+
+// This function applies the real-time mode to the calling thread: SCHED_FIFO priority, a pinned CPU,
+// locked memory and minimal timer slack. Each step is independent and a refusal only prints a warning,
+// so an unprivileged run keeps whatever the system allows.
+void apply_realtime_timing(realtime_timing_report& timing_report) {
+    timing_report.fifo_priority = launch_options.realtime_priority;
+    sched_param fifo_parameters{};
+    fifo_parameters.sched_priority = timing_report.fifo_priority;
+    int fifo_result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &fifo_parameters);
+    timing_report.fifo_applied = fifo_result == 0;
+    if (!timing_report.fifo_applied) {
+        console_error << "Real-time: SCHED_FIFO priority " << timing_report.fifo_priority << " refused ("
+                      << strerror(fifo_result) << "), keeping normal scheduling" << end_line;
+    }
+    
+    // The last CPU by default, which is the one least likely to carry the system's interrupt work
+    int cpu_count = max(1, static_cast<int>(thread::hardware_concurrency()));
+    timing_report.timing_cpu = launch_options.timing_cpu >= 0 ? launch_options.timing_cpu : cpu_count - 1;
+    cpu_set_t timing_cpu_set;
+    CPU_ZERO(&timing_cpu_set);
+    CPU_SET(timing_report.timing_cpu, &timing_cpu_set);
+    int affinity_result = pthread_setaffinity_np(pthread_self(), sizeof(timing_cpu_set), &timing_cpu_set);
+    timing_report.affinity_applied = affinity_result == 0;
+    if (!timing_report.affinity_applied) {
+        console_error << "Real-time: cannot pin to CPU " << timing_report.timing_cpu << " ("
+                      << strerror(affinity_result) << "), leaving the thread unpinned" << end_line;
+    }
+    
+    // Locking future mappings under a finite RLIMIT_MEMLOCK would turn later allocations into failures,
+    // so without the privilege to exceed it only the pages mapped now are locked
+    rlimit lock_limit{};
+    getrlimit(RLIMIT_MEMLOCK, &lock_limit);
+    timing_report.future_pages_locked = geteuid() == 0 || lock_limit.rlim_cur == RLIM_INFINITY;
+    timing_report.memory_locked = mlockall(MCL_CURRENT | (timing_report.future_pages_locked ? MCL_FUTURE : 0)) == 0;
+    if (!timing_report.memory_locked) {
+        timing_report.future_pages_locked = false;
+        console_error << "Real-time: mlockall refused (" << strerror(errno) << "), page faults remain possible" << end_line;
+    }
+    
+    timing_report.timer_slack_reduced = prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL) == 0;
+    if (!timing_report.timer_slack_reduced) {
+        console_error << "Real-time: cannot reduce timer slack (" << strerror(errno) << ")" << end_line;
+    }
+    
+    console_output << "Real-time timing: SCHED_FIFO " << (timing_report.fifo_applied ? "on" : "off") << " (priority "
+                   << timing_report.fifo_priority << "), CPU " << timing_report.timing_cpu << " pinning "
+                   << (timing_report.affinity_applied ? "on" : "off") << ", memory "
+                   << (!timing_report.memory_locked ? "unlocked" : timing_report.future_pages_locked ? "locked" : "locked (current pages)")
+                   << ", timer slack " << (timing_report.timer_slack_reduced ? "1 ns" : "default") << end_line;
+}
+
+// This function ticks a 1 ms deadline on a fresh thread while CPU-bound processes load every CPU, first
+// with normal scheduling and then with the real-time mode applied to the ticking thread, and prints the
+// two lateness histograms side by side. Thread attributes end with each thread, so the first phase
+// cannot inherit anything from the second.
+int execute_realtime_jitter_stress_test(int phase_seconds) {
+    const microseconds tick_period(1000);
+    const milliseconds phase_duration(phase_seconds * 1000LL);
+    int load_process_count = max(2, static_cast<int>(thread::hardware_concurrency()) + 1);
+    
+    // Each load process sweeps its own copy of this buffer, competing for the caches as well as the CPU;
+    // it is allocated before forking because the children must not call the allocator
+    vector<uint8_t> load_buffer(4 * 1024 * 1024);
+    console_output << "REAL-TIME JITTER STRESS TEST: 1 ms ticks for " << phase_seconds << " s per phase, "
+                   << load_process_count << " CPU-bound load processes" << end_line;
+    console_output << flush_output;
+    vector<pid_t> load_processes;
+    pid_t test_process = getpid();
+    for (int process_index = 0; process_index < load_process_count; process_index++) {
+        pid_t load_process = fork();
+        if (load_process == 0) {
+            // A load process must not outlive the test, even if the test is killed before it can reap it
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (getppid() != test_process) {
+                _exit(0);
+            }
+            // Stores through a volatile pointer are observable, so the compiler must keep the sweep
+            volatile uint8_t* load_bytes = load_buffer.data();
+            for (size_t byte_index = 0;; byte_index = (byte_index + 64) % load_buffer.size()) {
+                load_bytes[byte_index] = static_cast<uint8_t>(load_bytes[byte_index] + 1);
+            }
+        }
+        if (load_process > 0) {
+            load_processes.push_back(load_process);
+        }
+    }
+    
+    frame_pacing_statistics phase_statistics[2];
+    realtime_timing_report timing_report;
+    for (int phase_index = 0; phase_index < 2; phase_index++) {
+        thread timing_thread([&, phase_index]() {
+            if (phase_index == 1) {
+                apply_realtime_timing(timing_report);
+            }
+            measure_periodic_wakeups(tick_period, phase_duration, phase_statistics[phase_index]);
+        });
+        timing_thread.join();
+    }
+    if (timing_report.memory_locked) {
+        munlockall();
+    }
+    for (pid_t load_process : load_processes) {
+        kill(load_process, SIGKILL);
+        waitpid(load_process, nullptr, 0);
+    }
+    
+    int last_bucket = 0;
+    for (const frame_pacing_statistics& statistics : phase_statistics) {
+        for (int bucket_index = 0; bucket_index < LATENESS_HISTOGRAM_BUCKETS; bucket_index++) {
+            if (statistics.lateness_histogram[bucket_index] > 0) {
+                last_bucket = max(last_bucket, bucket_index);
+            }
+        }
+    }
+    console_output << "\n  lateness us     |   normal | realtime" << end_line;
+    for (int bucket_index = 0; bucket_index <= last_bucket; bucket_index++) {
+        uint32_t normal_count = phase_statistics[0].lateness_histogram[bucket_index];
+        uint32_t realtime_count = phase_statistics[1].lateness_histogram[bucket_index];
+        if (normal_count == 0 && realtime_count == 0) {
+            continue;
+        }
+        long long bucket_start = bucket_index == 0 ? 0 : lateness_bucket_limit_microseconds(bucket_index - 1);
+        console_output << set_width(7) << bucket_start << " - " << set_width(6)
+                       << lateness_bucket_limit_microseconds(bucket_index) << " | " << set_width(8) << normal_count
+                       << " | " << set_width(8) << realtime_count << end_line;
+    }
+    console_output << "\n  phase    |  ticks | missed | p50 us | p99 us | p99.9 us | max us" << end_line;
+    const char* phase_names[2] = {"normal  ", "realtime"};
+    for (int phase_index = 0; phase_index < 2; phase_index++) {
+        const frame_pacing_statistics& statistics = phase_statistics[phase_index];
+        console_output << "  " << phase_names[phase_index] << " | " << set_width(6) << statistics.frames_rendered
+                       << " | " << set_width(6) << statistics.deadlines_missed << " | " << set_width(6)
+                       << lateness_percentile_microseconds(statistics, 0.50) << " | " << set_width(6)
+                       << lateness_percentile_microseconds(statistics, 0.99) << " | " << set_width(8)
+                       << lateness_percentile_microseconds(statistics, 0.999) << " | " << set_width(6)
+                       << statistics.maximum_lateness_nanoseconds / 1000 << end_line;
+    }
+    return 0;
+}
+
+#else
+
+// This function reports that the real-time mode relies on Linux scheduling interfaces
+void apply_realtime_timing(realtime_timing_report& timing_report) {
+    (void)timing_report;
+    console_error << "Real-time timing is only available on Linux; continuing with normal scheduling" << end_line;
+}
+
+// This function reports that the stress test relies on fork and Linux scheduling interfaces
+int execute_realtime_jitter_stress_test(int phase_seconds) {
+    (void)phase_seconds;
+    console_error << "The real-time jitter stress test is only available on Linux." << end_line;
+    return 1;
+}
+
+#endif
+
+#ifdef __linux__
+
+// This function registers one descriptor for input readiness with the sequence event loop
+static bool register_light_event_source(int descriptor, light_event_source source) {
+    epoll_event source_event{};
+    source_event.events = EPOLLIN;
+    source_event.data.u64 = source;
+    return epoll_ctl(sequence_event_loop.epoll_descriptor, EPOLL_CTL_ADD, descriptor, &source_event) == 0;
+}
+
+// This function creates the event loop of the built-in sequence: one epoll set over a deadline timerfd,
+// a signalfd for SIGINT, SIGTERM and SIGWINCH, standard input and the optional control socket. Signals
+// are blocked so they are only ever seen as readiness; the loop then owns every wait of the sequence.
+bool initialize_light_event_loop() {
+    sequence_event_loop = light_event_loop();
+    sequence_event_loop.epoll_descriptor = epoll_create1(EPOLL_CLOEXEC);
+    sequence_event_loop.timer_descriptor = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (sequence_event_loop.epoll_descriptor < 0 || sequence_event_loop.timer_descriptor < 0) {
+        console_error << "Event loop initialization failed: " << strerror(errno) << end_line;
+        shutdown_light_event_loop();
+        return false;
+    }
+    if (!register_light_event_source(sequence_event_loop.timer_descriptor, EVENT_SOURCE_TIMER)) {
+        console_error << "Event loop timer registration failed: " << strerror(errno) << end_line;
+        shutdown_light_event_loop();
+        return false;
+    }
+    
+    sigset_t sequence_signals;
+    sigemptyset(&sequence_signals);
+    sigaddset(&sequence_signals, SIGINT);
+    sigaddset(&sequence_signals, SIGTERM);
+    sigaddset(&sequence_signals, SIGWINCH);
+    sigprocmask(SIG_BLOCK, &sequence_signals, nullptr);
+    sequence_event_loop.signal_descriptor = signalfd(-1, &sequence_signals, SFD_CLOEXEC | SFD_NONBLOCK);
+    if (sequence_event_loop.signal_descriptor < 0 ||
+        !register_light_event_source(sequence_event_loop.signal_descriptor, EVENT_SOURCE_SIGNAL)) {
+        // Blocked signals nobody reads would leave Ctrl+C without effect; shutting down unblocks them again
+        console_error << "Event loop signal setup failed: " << strerror(errno) << end_line;
+        shutdown_light_event_loop();
+        return false;
+    }
+    
+    // Regular files cannot be polled and are refused by epoll; such an input simply carries no commands
+    sequence_event_loop.stdin_registered = register_light_event_source(STDIN_FILENO, EVENT_SOURCE_STDIN);
+    
+    if (!launch_options.control_socket_path.empty()) {
+        sockaddr_un socket_address{};
+        socket_address.sun_family = AF_UNIX;
+        if (launch_options.control_socket_path.size() >= sizeof(socket_address.sun_path)) {
+            console_error << "Control socket path is too long: " << launch_options.control_socket_path << end_line;
+            shutdown_light_event_loop();
+            return false;
+        }
+        memcpy(socket_address.sun_path, launch_options.control_socket_path.c_str(), launch_options.control_socket_path.size());
+        unlink(launch_options.control_socket_path.c_str());
+        sequence_event_loop.control_descriptor = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+        if (sequence_event_loop.control_descriptor < 0 ||
+            bind(sequence_event_loop.control_descriptor, reinterpret_cast<sockaddr*>(&socket_address), sizeof(socket_address)) != 0) {
+            console_error << "Cannot bind control socket " << launch_options.control_socket_path << ": " << strerror(errno) << end_line;
+            shutdown_light_event_loop();
+            return false;
+        }
+        if (!register_light_event_source(sequence_event_loop.control_descriptor, EVENT_SOURCE_CONTROL)) {
+            console_error << "Cannot watch control socket " << launch_options.control_socket_path << ": " << strerror(errno) << end_line;
+            shutdown_light_event_loop();
+            return false;
+        }
+    }
+    return true;
+}
+
+// This function closes the event loop's descriptors, removes the control socket and unblocks its signals
+void shutdown_light_event_loop() {
+    if (sequence_event_loop.epoll_descriptor < 0 && sequence_event_loop.timer_descriptor < 0) {
+        return;
+    }
+    int* descriptors[] = {&sequence_event_loop.epoll_descriptor, &sequence_event_loop.timer_descriptor,
+                          &sequence_event_loop.signal_descriptor, &sequence_event_loop.control_descriptor};
+    for (int* descriptor : descriptors) {
+        if (*descriptor >= 0) {
+            close(*descriptor);
+            *descriptor = -1;
+        }
+    }
+    if (!launch_options.control_socket_path.empty()) {
+        unlink(launch_options.control_socket_path.c_str());
+    }
+    sigset_t sequence_signals;
+    sigemptyset(&sequence_signals);
+    sigaddset(&sequence_signals, SIGINT);
+    sigaddset(&sequence_signals, SIGTERM);
+    sigaddset(&sequence_signals, SIGWINCH);
+    sigprocmask(SIG_UNBLOCK, &sequence_signals, nullptr);
+}
+
+// This function carries out one command line from standard input or the control socket
+static void handle_light_event_command(string_view command) {
+    while (!command.empty() && (command.back() == '\r' || command.back() == ' ')) {
+        command.remove_suffix(1);
+    }
+    if (command.empty()) {
+        return;
+    }
+    sequence_event_loop.commands_handled++;
+    if (command == "stop" || command == "quit" || command == "q") {
+        sequence_event_loop.stop_requested = true;
+        console_output << "\nStop requested" << end_line;
+    } else if (command == "status") {
+        console_output << "\nEvent loop: " << sequence_event_loop.wakeups << " wakeups, "
+                       << sequence_event_loop.timer_expirations << " timer expirations, "
+                       << sequence_event_loop.commands_handled << " commands, "
+                       << sequence_event_loop.signals_handled << " signals" << end_line;
+    } else {
+        console_output << "\nUnknown command \"" << command << "\" (stop, status)" << end_line;
+    }
+}
+
+// This function services one ready source other than the deadline timer
+static void dispatch_light_event(uint64_t event_source) {
+    if (event_source == EVENT_SOURCE_SIGNAL) {
+        signalfd_siginfo signal_information;
+        while (read(sequence_event_loop.signal_descriptor, &signal_information, sizeof(signal_information)) ==
+               static_cast<ssize_t>(sizeof(signal_information))) {
+            sequence_event_loop.signals_handled++;
+            if (signal_information.ssi_signo == SIGWINCH) {
+                // Later frames are composed for the new size; the workspace only grows
+                detected_terminal = detect_terminal_capabilities();
+                prepare_render_workspace();
+            } else {
+                sequence_event_loop.stop_requested = true;
+            }
+        }
+    } else if (event_source == EVENT_SOURCE_STDIN) {
+        char input_bytes[256];
+        ssize_t byte_count = read(STDIN_FILENO, input_bytes, sizeof(input_bytes));
+        if (byte_count <= 0) {
+            // End of input, such as /dev/null, stays readable forever and must leave the set; an interrupted
+            // or drained read keeps standard input registered
+            if (byte_count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                epoll_ctl(sequence_event_loop.epoll_descriptor, EPOLL_CTL_DEL, STDIN_FILENO, nullptr);
+                sequence_event_loop.stdin_registered = false;
+            }
+            return;
+        }
+        // Lines are assembled in a fixed buffer, so command input never reaches the heap
+        for (ssize_t byte_index = 0; byte_index < byte_count; byte_index++) {
+            if (input_bytes[byte_index] == '\n') {
+                handle_light_event_command(string_view(sequence_event_loop.pending_input,
+                                                       sequence_event_loop.pending_input_length));
+                sequence_event_loop.pending_input_length = 0;
+            } else if (sequence_event_loop.pending_input_length < sizeof(sequence_event_loop.pending_input)) {
+                sequence_event_loop.pending_input[sequence_event_loop.pending_input_length++] = input_bytes[byte_index];
+            }
+        }
+    } else if (event_source == EVENT_SOURCE_CONTROL) {
+        char datagram[256];
+        ssize_t byte_count;
+        while ((byte_count = recv(sequence_event_loop.control_descriptor, datagram, sizeof(datagram), 0)) > 0) {
+            string_view command(datagram, static_cast<size_t>(byte_count));
+            while (!command.empty() && command.back() == '\n') {
+                command.remove_suffix(1);
+            }
+            handle_light_event_command(command);
+        }
+    }
+}
+
+// This function runs the event loop until an absolute deadline and returns true, or returns false once a
+// stop is requested. The timerfd fires spin_margin_microseconds early, like every other deadline wait,
+// and commands or signals arriving meanwhile are handled on this thread without delaying the deadline.
+bool wait_in_light_event_loop(steady_clock::time_point deadline) {
+    if (sequence_event_loop.epoll_descriptor < 0) {
+        wait_until_absolute_deadline(deadline);
+        return !sequence_event_loop.stop_requested;
+    }
+    steady_clock::time_point wake_time = deadline - microseconds(launch_options.spin_margin_microseconds);
+    if (!sequence_event_loop.stop_requested && steady_clock::now() < wake_time) {
+        long long wake_nanoseconds = duration_cast<nanoseconds>(wake_time.time_since_epoch()).count();
+        itimerspec timer_setting = {};
+        timer_setting.it_value.tv_sec = static_cast<time_t>(wake_nanoseconds / 1000000000LL);
+        timer_setting.it_value.tv_nsec = static_cast<long>(wake_nanoseconds % 1000000000LL);
+        timerfd_settime(sequence_event_loop.timer_descriptor, TFD_TIMER_ABSTIME, &timer_setting, nullptr);
+        
+        bool deadline_reached = false;
+        while (!deadline_reached && !sequence_event_loop.stop_requested) {
+            epoll_event ready_events[4];
+            int ready_count = epoll_wait(sequence_event_loop.epoll_descriptor, ready_events, 4, -1);
+            sequence_event_loop.wakeups++;
+            for (int event_index = 0; event_index < ready_count; event_index++) {
+                uint64_t expiration_count;
+                if (ready_events[event_index].data.u64 != EVENT_SOURCE_TIMER) {
+                    dispatch_light_event(ready_events[event_index].data.u64);
+                } else if (read(sequence_event_loop.timer_descriptor, &expiration_count, sizeof(expiration_count)) > 0) {
+                    sequence_event_loop.timer_expirations++;
+                    deadline_reached = true;
+                }
+            }
+        }
+    }
+    if (sequence_event_loop.stop_requested) {
+        return false;
+    }
+    spin_until_absolute_deadline(deadline);
+    return true;
+}
+
+// This function plays a long continuous illumination on the event loop with console output discarded and
+// reports how often the process woke up and how much CPU it used while the light was steady
+int execute_event_loop_benchmark(int duration_seconds) {
+    console_output << "EVENT LOOP BENCHMARK: " << duration_seconds << " s of continuous illumination, console output discarded"
+                   << end_line;
+    if (!initialize_light_event_loop()) {
+        return 1;
+    }
+    rusage starting_usage{};
+    getrusage(RUSAGE_SELF, &starting_usage);
+    long long cpu_start = process_cpu_microseconds();
+    steady_clock::time_point benchmark_start = steady_clock::now();
+    int console_descriptor = console_output.redirect(-1);
+    execute_continuous_illumination_mode(duration_seconds);
+    console_output.redirect(console_descriptor);
+    double elapsed_seconds = duration_cast<microseconds>(steady_clock::now() - benchmark_start).count() / 1e6;
+    long long cpu_used = process_cpu_microseconds() - cpu_start;
+    rusage final_usage{};
+    getrusage(RUSAGE_SELF, &final_usage);
+    
+    console_output << fixed_decimals(2);
+    console_output << "Elapsed:                   " << elapsed_seconds << " s" << end_line;
+    console_output << "Event loop wakeups:        " << sequence_event_loop.wakeups << " ("
+                   << sequence_event_loop.wakeups / elapsed_seconds << " per second), "
+                   << sequence_event_loop.timer_expirations << " timer expirations" << end_line;
+    console_output << "Voluntary context switches: " << final_usage.ru_nvcsw - starting_usage.ru_nvcsw << " ("
+                   << (final_usage.ru_nvcsw - starting_usage.ru_nvcsw) / elapsed_seconds << " per second)" << end_line;
+    console_output << "CPU time:                  " << cpu_used / 1000.0 << " ms ("
+                   << fixed_decimals(4) << 100.0 * cpu_used / (elapsed_seconds * 1e6) << " % of one CPU)" << end_line;
+    console_output << general_float;
+    shutdown_light_event_loop();
+    return 0;
+}
+
+#else
+
+// This function leaves the sequence on plain deadline waits where epoll, timerfd and signalfd are missing
+bool initialize_light_event_loop() {
+    return true;
+}
+
+void shutdown_light_event_loop() {}
+
+// This function waits for the deadline; without an event loop no command can stop the sequence early
+bool wait_in_light_event_loop(steady_clock::time_point deadline) {
+    wait_until_absolute_deadline(deadline);
+    return !sequence_event_loop.stop_requested;
+}
+
+// This function reports that the event loop benchmark relies on epoll and getrusage
+int execute_event_loop_benchmark(int duration_seconds) {
+    (void)duration_seconds;
+    console_error << "The event loop benchmark is only available on Linux." << end_line;
+    return 1;
+}
+
+#endif
+
+// This function prints one beacon status report: run time, edge accuracy, wakeups and CPU time
+static void write_beacon_report(const beacon_run_statistics& statistics) {
+    double elapsed_hours = duration_cast<microseconds>(steady_clock::now() - statistics.started).count() / 3.6e9;
+    long long wakeups = sequence_event_loop.wakeups - statistics.wakeups_at_start;
+    long long cpu_used = process_cpu_microseconds() - statistics.cpu_start_microseconds;
+    console_output << fixed_decimals(2) << "\nBeacon: " << elapsed_hours << " h lit, " << statistics.edges_shown
+                   << " edges (p50 " << lateness_percentile_microseconds(statistics.edge_pacing, 0.50) << " us, p99 "
+                   << lateness_percentile_microseconds(statistics.edge_pacing, 0.99) << " us late), " << wakeups
+                   << " wakeups (" << fixed_decimals(0) << wakeups / max(elapsed_hours, 1e-9) << " per hour), CPU "
+                   << fixed_decimals(2) << cpu_used / 1000.0
+                   << " ms" << general_float << end_line;
+}
+
+// This function keeps a beacon lit on the event loop for run_length, or until stopped when it is zero.
+// A steady beacon is drawn once and the loop then sleeps until the next status report; a pattern beacon
+// wakes only for its light edges, which sit on absolute deadlines from the start so they never drift.
+// A report falling due shortly before an edge is printed on that edge's wakeup instead of on its own.
+static void run_light_beacon(const synchronized_cycle* beacon_cycle, microseconds run_length,
+                             beacon_run_statistics& statistics) {
+    statistics.started = steady_clock::now();
+    statistics.cpu_start_microseconds = process_cpu_microseconds();
+    statistics.wakeups_at_start = sequence_event_loop.wakeups;
+    steady_clock::time_point beacon_end =
+        run_length.count() > 0 ? statistics.started + run_length : steady_clock::time_point::max();
+    const minutes report_interval(launch_options.beacon_report_minutes);
+    steady_clock::time_point report_deadline = statistics.started + report_interval;
+    if (beacon_cycle == nullptr) {
+        generate_illumination_pattern(PATTERN_STEADY_BRIGHT, 100);
+    }
+    
+    long long cycle_index = 0;
+    size_t edge_index = 0;
+    for (;;) {
+        steady_clock::time_point edge_deadline = beacon_cycle == nullptr ? steady_clock::time_point::max()
+            : statistics.started + microseconds(cycle_index * beacon_cycle->cycle_microseconds +
+                                                beacon_cycle->edges[edge_index].offset_microseconds);
+        bool report_on_edge = edge_deadline - report_deadline <= microseconds(BEACON_REPORT_COALESCING_MICROSECONDS);
+        steady_clock::time_point wake_deadline = min(beacon_end, report_on_edge ? edge_deadline : min(edge_deadline, report_deadline));
+        if (!wait_in_light_event_loop(wake_deadline)) {
+            break;
+        }
+        
+        if (wake_deadline == edge_deadline) {
+            const timeline_edge& edge = beacon_cycle->edges[edge_index];
+            record_frame_lateness(statistics.edge_pacing, duration_cast<nanoseconds>(steady_clock::now() - edge_deadline).count());
+            generate_illumination_pattern(edge.pattern, edge.intensity_level);
+            statistics.edges_shown++;
+            if (++edge_index == beacon_cycle->edge_count) {
+                edge_index = 0;
+                cycle_index++;
+            }
+        }
+        if (steady_clock::now() >= report_deadline) {
+            write_beacon_report(statistics);
+            statistics.reports_written++;
+            statistics.reports_coalesced += report_on_edge ? 1 : 0;
+            while (report_deadline <= steady_clock::now()) {
+                report_deadline += report_interval;
+            }
+        }
+        if (wake_deadline == beacon_end) {
+            break;
+        }
+    }
+    generate_illumination_pattern(PATTERN_OFF, 0);
+}
+
+// This function runs the beacon requested with --beacon on the event loop, so stop commands, the control
+// socket and termination signals end it cleanly, and prints a final report
+int execute_beacon_mode() {
+    const synchronized_cycle* beacon_cycle = launch_options.beacon_pattern_name == "steady"
+        ? nullptr : find_synchronized_cycle(launch_options.beacon_pattern_name);
+    if (!initialize_light_event_loop()) {
+        return 1;
+    }
+    console_output << "BEACON MODE: " << launch_options.beacon_pattern_name << ", report every "
+                   << launch_options.beacon_report_minutes << " min, ";
+    if (launch_options.beacon_hours > 0.0) {
+        console_output << launch_options.beacon_hours << " h";
+    } else {
+        console_output << "until stopped";
+    }
+    console_output << " (type stop or send SIGTERM to end)" << end_line;
+    
+    beacon_run_statistics statistics;
+    run_light_beacon(beacon_cycle, microseconds(llround(launch_options.beacon_hours * 3.6e9)), statistics);
+    write_beacon_report(statistics);
+    console_output << "Beacon ended: " << statistics.reports_written << " reports, " << statistics.reports_coalesced
+                   << " sharing an edge wakeup" << end_line;
+    shutdown_light_event_loop();
+    return 0;
+}
+
+// This function compares the per-second continuous illumination with each beacon pattern over the same
+// run length, output discarded, and extrapolates wakeups and CPU time to an hour
+int execute_beacon_benchmark(int duration_seconds) {
+    const char* beacon_patterns[] = {"continuous", "steady", "strobe", "sos"};
+    console_output << "BEACON BENCHMARK: " << duration_seconds << " s per pattern, console output discarded, reports every "
+                   << launch_options.beacon_report_minutes << " min" << end_line;
+    console_output << "  pattern    |  edges | wakeups | wakeups/h | CPU ms | CPU s/day | edge p50 us | p99 us | max us" << end_line;
+    if (!initialize_light_event_loop()) {
+        return 1;
+    }
+    for (const char* pattern_name : beacon_patterns) {
+        beacon_run_statistics statistics;
+        int console_descriptor = console_output.redirect(-1);
+        if (string_view(pattern_name) == "continuous") {
+            // The built-in continuous phase, which narrates and wakes once per second
+            statistics.started = steady_clock::now();
+            statistics.cpu_start_microseconds = process_cpu_microseconds();
+            statistics.wakeups_at_start = sequence_event_loop.wakeups;
+            execute_continuous_illumination_mode(duration_seconds);
+        } else {
+            const synchronized_cycle* beacon_cycle =
+                string_view(pattern_name) == "steady" ? nullptr : find_synchronized_cycle(pattern_name);
+            run_light_beacon(beacon_cycle, seconds(duration_seconds), statistics);
+        }
+        console_output.redirect(console_descriptor);
+        if (sequence_event_loop.stop_requested) {
+            break;
+        }
+        
+        double elapsed_hours = duration_cast<microseconds>(steady_clock::now() - statistics.started).count() / 3.6e9;
+        long long wakeups = sequence_event_loop.wakeups - statistics.wakeups_at_start;
+        long long cpu_used = process_cpu_microseconds() - statistics.cpu_start_microseconds;
+        console_output << "  " << pattern_name << string(11 - strlen(pattern_name), ' ') << "| " << set_width(6)
+                       << statistics.edges_shown << " | " << set_width(7) << wakeups << " | " << fixed_decimals(0)
+                       << set_width(9) << wakeups / elapsed_hours << " | " << fixed_decimals(2) << set_width(6)
+                       << cpu_used / 1000.0 << " | " << set_width(9) << cpu_used / 1e6 / elapsed_hours * 24.0
+                       << general_float << " | " << set_width(11)
+                       << lateness_percentile_microseconds(statistics.edge_pacing, 0.50) << " | " << set_width(6)
+                       << lateness_percentile_microseconds(statistics.edge_pacing, 0.99) << " | " << set_width(6)
+                       << statistics.edge_pacing.maximum_lateness_nanoseconds / 1000 << end_line;
+    }
+    console_output << "The last wakeup of each run only ends it; an endless steady beacon wakes once per report." << end_line;
+    shutdown_light_event_loop();
+    return 0;
 }
\ No newline at end of file